@@ -28,6 +28,12 @@
   #define MEMCOPY_BASE XPAR_MEMCOPY_ACCEL_0_BASEADDR
 #endif
 
+/* Second channel: a second memcopy_accel instance, if the design has one */
+#ifdef XPAR_MEMCOPY_ACCEL_1_BASEADDR
+  #define MEMCOPY_BASE1    XPAR_MEMCOPY_ACCEL_1_BASEADDR
+  #define MEMCOPY_INTR_ID1 XPAR_FABRIC_MEMCOPY_ACCEL_1_INTR
+#endif
+
 #ifndef XPAR_CPU_CORE_CLOCK_FREQ_HZ
   #ifdef XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ
     #define CPU_FREQ XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ
@@ -51,20 +57,43 @@ void cpu_memcopy(uint32_t* src, uint32_t* dst, uint32_t len_bytes) {
 
 /* Global variables */
 static XScuGic Intc;
-static volatile int memcopy_done = 0;
+static volatile uint32_t memcopy_done_count = 0;   /* ap_done interrupts seen */
+static volatile uint32_t memcopy_repeat_left = 0;  /* auto_restart runs still to go */
+static volatile uint32_t memcopy_ch_done_count[MEMCOPY_ACCEL_NUM_CHANNELS];
+
+/* Base address and interrupt of each channel present in the design */
+static const UINTPTR ch_base[] = {
+    MEMCOPY_BASE,
+#ifdef MEMCOPY_BASE1
+    MEMCOPY_BASE1,
+#endif
+};
+static const uint32_t ch_intr[] = {
+    MEMCOPY_INTR_ID,
+#ifdef MEMCOPY_BASE1
+    MEMCOPY_INTR_ID1,
+#endif
+};
+#define NUM_CH  ((uint32_t)(sizeof(ch_base) / sizeof(ch_base[0])))
+_Static_assert(sizeof(ch_base) / sizeof(ch_base[0]) <= MEMCOPY_ACCEL_NUM_CHANNELS, "too many channels");
 
 /* ----------------------------------------------------
  * Interrupt service routine for memcopy_accel
  * ---------------------------------------------------- */
 void memcopy_isr(void *CallbackRef)
 {
-    (void)CallbackRef;
-    memcopy_accel_interrupt_clear();
+    uint32_t ch = (uint32_t)(UINTPTR)CallbackRef;   /* channel index */
+
+    // Last auto_restart run: drop auto_restart before releasing the IP
+    if (ch == 0 && memcopy_repeat_left > 0 && --memcopy_repeat_left == 0)
+        memcopy_accel_set_auto_restart(false);
 
-    // Read-back to flush AXI write and avoid IRQ retrigger (required on Zynq)
-    (void)Xil_In32(MEMCOPY_BASE + MEMCOPY_ACCEL_ISR_OFFSET);  // read-back barrier
+    // Clear, acknowledge ap_done, complete the job (callback) and start the next
+    memcopy_ch_irq(ch);
 
-    memcopy_done = 1;
+    memcopy_ch_done_count[ch]++;
+    if (ch == 0)
+        memcopy_done_count++;
 }
 
 /* ================== Interrupt Setup ================== */
@@ -86,28 +115,522 @@ int setup_interrupt_system(void)
                                  (Xil_ExceptionHandler)XScuGic_InterruptHandler,
                                  &Intc);
 
-    Status = XScuGic_Connect(&Intc,
-                             MEMCOPY_ACCEL_INTR_ID,
-                             (Xil_InterruptHandler)memcopy_isr,
-                             NULL);
-    if (Status != XST_SUCCESS)
-        return XST_FAILURE;
+    for (uint32_t ch = 0; ch < NUM_CH; ++ch) {
+        Status = XScuGic_Connect(&Intc,
+                                 ch_intr[ch],
+                                 (Xil_InterruptHandler)memcopy_isr,
+                                 (void *)(UINTPTR)ch);
+        if (Status != XST_SUCCESS)
+            return XST_FAILURE;
 
-    XScuGic_Enable(&Intc, MEMCOPY_ACCEL_INTR_ID);
+        XScuGic_Enable(&Intc, ch_intr[ch]);
+    }
     Xil_ExceptionEnable();
-    memcopy_accel_interrupt_enable();
+    for (uint32_t ch = 0; ch < NUM_CH; ++ch)
+        memcopy_ch_interrupt_enable(ch);
     xil_printf("Interrupt system setup complete.\r\n");
     return XST_SUCCESS;
 }
 
 
+/* Submit a job on channel 0 and sleep until it is done, 2 s timeout */
+static int run_job(memcopy_job_t *job)
+{
+    if (memcopy_wait(memcopy_submit(0, job), 2000000) != 0) {
+        xil_printf("ERROR: Timeout waiting for accelerator job!\r\n");
+        return -1;
+    }
+    return 0;
+}
+
+/* Wait until the ISR has counted `count` completions, 2 s timeout */
+static int wait_done_count(uint32_t count)
+{
+    XTime tStartWFI, tNow;
+    XTime_GetTime(&tStartWFI);
+    const XTime TIMEOUT_VAL = (XTime)COUNTS_PER_SECOND * 2;
+
+    while (memcopy_done_count < count) {
+        __asm__ volatile ("wfi");
+        XTime_GetTime(&tNow);
+        if ((tNow - tStartWFI) > TIMEOUT_VAL) {
+            xil_printf("ERROR: Timeout, %u of %u jobs done\r\n", memcopy_done_count, count);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Small-transfer throughput with ap_ctrl_chain: NUM_JOBS copies of
+   JOB_BYTES issued one at a time (start, wait for the interrupt), then
+   queued (the next job is written as soon as the IP has latched the current
+   one), then as one job rerun by the IP itself with auto_restart */
+static void run_queue_bench(uint8_t *src, uint8_t *dst)
+{
+    const uint32_t NUM_JOBS = 64, JOB_BYTES = 256;
+    memcopy_job_t job;
+    XTime t0, t1;
+    uint32_t us_serial, us_queued, us_repeat;
+
+    memcopy_ch_cache_flush(0, src, NUM_JOBS * JOB_BYTES);
+    memcopy_ch_cache_flush(0, dst, NUM_JOBS * JOB_BYTES);
+
+    XTime_GetTime(&t0);
+    for (uint32_t i = 0; i < NUM_JOBS; ++i) {
+        memcopy_job_init(&job, MEMCOPY_OP_COPY, (UINTPTR)(src + i * JOB_BYTES),
+                         (UINTPTR)(dst + i * JOB_BYTES), JOB_BYTES);
+        if (run_job(&job) != 0)
+            return;
+    }
+    XTime_GetTime(&t1);
+    us_serial = (uint32_t)((t1 - t0) / (COUNTS_PER_SECOND / 1000000));
+
+    memcopy_done_count = 0;
+    XTime_GetTime(&t0);
+    for (uint32_t i = 0; i < NUM_JOBS; ++i) {
+        while (!memcopy_accel_is_ready()) { /* previous job not latched yet */ }
+        memcopy_accel_start((UINTPTR)(src + i * JOB_BYTES), (UINTPTR)(dst + i * JOB_BYTES), JOB_BYTES);
+    }
+    if (wait_done_count(NUM_JOBS) != 0)
+        return;
+    XTime_GetTime(&t1);
+    us_queued = (uint32_t)((t1 - t0) / (COUNTS_PER_SECOND / 1000000));
+
+    memcopy_done_count = 0;
+    memcopy_repeat_left = NUM_JOBS;
+    XTime_GetTime(&t0);
+    memcopy_accel_set_auto_restart(true);
+    memcopy_accel_start((UINTPTR)src, (UINTPTR)dst, JOB_BYTES);
+    if (wait_done_count(NUM_JOBS) != 0)
+        return;
+    XTime_GetTime(&t1);
+    us_repeat = (uint32_t)((t1 - t0) / (COUNTS_PER_SECOND / 1000000));
+
+    xil_printf("%u x %u-byte jobs: serial %u us, queued %u us, auto_restart %u us\r\n",
+               NUM_JOBS, JOB_BYTES, us_serial, us_queued, us_repeat);
+}
+
+/* Wait until channel ch has counted `count` completions, 2 s timeout */
+static int wait_ch_done_count(uint32_t ch, uint32_t count)
+{
+    XTime tStartWFI, tNow;
+    XTime_GetTime(&tStartWFI);
+    const XTime TIMEOUT_VAL = (XTime)COUNTS_PER_SECOND * 2;
+
+    while (memcopy_ch_done_count[ch] < count) {
+        __asm__ volatile ("wfi");
+        XTime_GetTime(&tNow);
+        if ((tNow - tStartWFI) > TIMEOUT_VAL) {
+            xil_printf("ERROR: Timeout on channel %u\r\n", ch);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Two independent copies of len bytes, first both on channel 0 and then
+   one per channel at the same time, each checked with a compare on its
+   own channel. Only run when the design has a second instance. */
+static void run_multichannel_bench(uint8_t *src, uint8_t *dst, uint32_t len)
+{
+    XTime t0, t1;
+    uint32_t us_one, us_all;
+    uint32_t target[MEMCOPY_ACCEL_NUM_CHANNELS];
+    int errors = 0;
+
+    memcopy_ch_cache_flush(0, src, NUM_CH * len);
+    memcopy_ch_cache_flush(0, dst, NUM_CH * len);
+
+    target[0] = memcopy_ch_done_count[0] + NUM_CH;
+    XTime_GetTime(&t0);
+    for (uint32_t ch = 0; ch < NUM_CH; ++ch) {
+        while (!memcopy_accel_is_ready()) { /* previous job not latched yet */ }
+        memcopy_accel_start((UINTPTR)(src + ch * len), (UINTPTR)(dst + ch * len), len);
+    }
+    if (wait_ch_done_count(0, target[0]) != 0)
+        return;
+    XTime_GetTime(&t1);
+    us_one = (uint32_t)((t1 - t0) / (COUNTS_PER_SECOND / 1000000));
+
+    XTime_GetTime(&t0);
+    for (uint32_t ch = 0; ch < NUM_CH; ++ch) {
+        target[ch] = memcopy_ch_done_count[ch] + 1;
+        memcopy_ch_start(ch, (UINTPTR)(src + ch * len), (UINTPTR)(dst + ch * len), len);
+    }
+    for (uint32_t ch = 0; ch < NUM_CH; ++ch)
+        if (wait_ch_done_count(ch, target[ch]) != 0)
+            return;
+    XTime_GetTime(&t1);
+    us_all = (uint32_t)((t1 - t0) / (COUNTS_PER_SECOND / 1000000));
+
+    for (uint32_t ch = 0; ch < NUM_CH; ++ch) {
+        target[ch] = memcopy_ch_done_count[ch] + 1;
+        memcopy_ch_start_compare(ch, (UINTPTR)(src + ch * len), (UINTPTR)(dst + ch * len), len);
+    }
+    for (uint32_t ch = 0; ch < NUM_CH; ++ch) {
+        if (wait_ch_done_count(ch, target[ch]) != 0)
+            return;
+        if (!memcopy_ch_get_compare(ch, NULL, NULL))
+            errors++;
+    }
+
+    xil_printf("%u x %u-byte copies: one channel %u us, %u channels %u us, %s\r\n",
+               NUM_CH, len, us_one, NUM_CH, us_all, errors ? "FAILED" : "PASSED");
+}
+
+/* Compare two buffers in the PL instead of a CPU loop through the cache.
+   Returns the number of differing bytes (0 = equal) or -1 on timeout.
+   Both ranges must be flushed from the cache. */
+static int hw_compare(const void *a, const void *b, uint32_t len, const char *what)
+{
+    memcopy_job_t job;
+
+    memcopy_job_init(&job, MEMCOPY_OP_CMP, (UINTPTR)a, (UINTPTR)b, len);
+    if (run_job(&job) != 0)
+        return -1;
+
+    if (job.cmp_match)
+        return 0;
+    xil_printf("%s: %u bytes differ, first at byte %u\r\n", what, (uint32_t)job.cmp_count, (uint32_t)job.cmp_first);
+    return (int)job.cmp_count;
+}
+
+/* Job callback, runs in memcopy_isr: add the job's bytes to *arg */
+static void count_job_bytes(memcopy_job_t *job, void *arg)
+{
+    *(uint32_t *)arg += job->len;
+}
+
+/* A full queue of copies in flight while the CPU keeps working (here it
+   sums src words) until the last ticket is done; the callbacks count the
+   bytes and the hardware compare checks the data */
+static void run_async_test(uint8_t *src, uint8_t *dst)
+{
+    enum { NUM_JOBS = MEMCOPY_JOB_QUEUE_DEPTH, JOB_BYTES = 1024, WORDS = NUM_JOBS * JOB_BYTES / 4 };
+    static memcopy_job_t jobs[NUM_JOBS];
+    static uint32_t bytes_done;
+    memcopy_ticket_t ticket = MEMCOPY_TICKET_NONE;
+    const uint32_t *w = (const uint32_t *)src;
+    uint32_t sum = 0, cpu_words = 0;
+
+    memcopy_ch_cache_flush(0, src, NUM_JOBS * JOB_BYTES);
+    memcopy_ch_cache_flush(0, dst, NUM_JOBS * JOB_BYTES);
+
+    bytes_done = 0;
+    for (uint32_t i = 0; i < NUM_JOBS; ++i) {
+        memcopy_job_init(&jobs[i], MEMCOPY_OP_COPY, (UINTPTR)(src + i * JOB_BYTES),
+                         (UINTPTR)(dst + i * JOB_BYTES), JOB_BYTES);
+        jobs[i].cb = count_job_bytes;
+        jobs[i].arg = &bytes_done;
+        ticket = memcopy_submit(0, &jobs[i]);
+        if (ticket == MEMCOPY_TICKET_NONE) {
+            xil_printf("ERROR: job queue full at job %u\r\n", i);
+            return;
+        }
+    }
+
+    while (!memcopy_ticket_done(ticket) && cpu_words < 100000000u)
+        sum += w[cpu_words++ % WORDS];
+    if (memcopy_wait(ticket, 2000000) != 0) {
+        xil_printf("ERROR: Timeout, %u of %u async bytes done\r\n", bytes_done, NUM_JOBS * JOB_BYTES);
+        return;
+    }
+
+    memcopy_queue_stats_t qs;
+    memcopy_ch_get_queue_stats(0, &qs);
+    xil_printf("Job queue: %u submitted, %u rejected, high water %u of %u, %u started from the ISR\r\n",
+               qs.submitted, qs.rejected, qs.high_water, MEMCOPY_JOB_QUEUE_DEPTH, qs.started_chained);
+
+    if (bytes_done == NUM_JOBS * JOB_BYTES && hw_compare(src, dst, NUM_JOBS * JOB_BYTES, "Async") == 0)
+        xil_printf("Async test PASSED! (%u jobs in flight, CPU summed %u words meanwhile, sum 0x%08x)\r\n",
+                   NUM_JOBS, cpu_words, sum);
+    else
+        xil_printf("Async test FAILED (%u of %u bytes reported)\r\n", bytes_done, NUM_JOBS * JOB_BYTES);
+}
+
+/* Command ring: NUM_JOBS copies enqueued with memory writes and a single
+   doorbell, reaped as the moderated interrupts arrive, then a stop command.
+   Reports how many interrupts the jobs took and checks the copies. */
+static void run_ring_test(uint8_t *src, uint8_t *dst)
+{
+    enum { SLOTS = 16, NUM_JOBS = 12, JOB_BYTES = 256, IRQ_COUNT = 4, IRQ_IDLE = 256 };
+    static memcopy_ring_t ring;
+    static memcopy_desc_t cmd[SLOTS];
+    static memcopy_cpl_t cpl[SLOTS + 1];
+    memcopy_cpl_t c;
+    XTime t0, tNow;
+    uint32_t reaped = 0;
+    int errors = 0;
+
+    memcopy_ch_cache_flush(0, src, NUM_JOBS * JOB_BYTES);
+    memcopy_ch_cache_invalidate(0, dst, NUM_JOBS * JOB_BYTES);
+
+    uint32_t irqs = memcopy_done_count;
+    if (memcopy_ring_start(&ring, 0, cmd, cpl, SLOTS, IRQ_COUNT, IRQ_IDLE) != 0)
+        return;
+    for (uint32_t i = 0; i < NUM_JOBS; ++i)
+        memcopy_ring_add(&ring, (UINTPTR)(src + i * JOB_BYTES), (UINTPTR)(dst + i * JOB_BYTES),
+                         JOB_BYTES, i);
+    memcopy_ring_doorbell(&ring);
+
+    XTime_GetTime(&t0);
+    bool stopped = false;
+    while (!stopped) {
+        uint32_t seen = memcopy_done_count;
+        while (memcopy_ring_reap(&ring, &c)) {
+            if (c.status & MEMCOPY_CPL_STOP) {
+                stopped = true;
+                break;
+            }
+            if (c.cookie != reaped || c.len != JOB_BYTES)
+                errors++;
+            if (++reaped == NUM_JOBS)
+                memcopy_ring_stop(&ring);
+        }
+        if (stopped)
+            break;
+        if (memcopy_done_count == seen)
+            __asm__ volatile ("wfi");
+        XTime_GetTime(&tNow);
+        if ((tNow - t0) > (XTime)COUNTS_PER_SECOND * 2) {
+            xil_printf("ERROR: Timeout, %u of %u ring jobs done\r\n", reaped, NUM_JOBS);
+            return;
+        }
+    }
+    irqs = memcopy_done_count - irqs;
+
+    if (hw_compare(src, dst, NUM_JOBS * JOB_BYTES, "Ring") != 0)
+        errors++;
+    if (errors == 0)
+        xil_printf("Ring test PASSED! (%u jobs, one doorbell, %u interrupts)\r\n", NUM_JOBS, irqs);
+    else
+        xil_printf("Ring test FAILED with %d errors.\r\n", errors);
+}
+
+/* Fill a buffer with the accelerator. The buffer must not have dirty lines
+   in the cache, so invalidate before (fresh allocation) and after the fill.
+   crc (may be NULL) gets the CRC-32 of the bytes written. */
+static int fill_buffer(void *buf, uint32_t len, uint32_t value, bool incr, uint32_t *crc)
+{
+    memcopy_job_t job;
+
+    memcopy_ch_cache_invalidate(0, buf, len);
+
+    memcopy_job_init(&job, incr ? MEMCOPY_OP_PATTERN : MEMCOPY_OP_FILL, 0, (UINTPTR)buf, len);
+    job.fill = value;
+    if (run_job(&job) != 0)
+        return -1;
+
+    memcopy_ch_cache_invalidate(0, buf, len);
+    if (crc)
+        *crc = job.crc;
+    return 0;
+}
+
+/* Copy an odd-length packet between unaligned addresses and check that the
+   bytes around the destination window are left untouched */
+static int run_unaligned_test(uint8_t *src, uint8_t *dst, uint32_t buf_len)
+{
+    const uint32_t SRC_OFF = 1, DST_OFF = 3, PKT_LEN = 1501;
+    memcopy_job_t job;
+    int errors = 0;
+
+    memset(dst, 0x5A, buf_len);
+    memcopy_ch_cache_flush(0, src, buf_len);
+    memcopy_ch_cache_flush(0, dst, buf_len);
+
+    memcopy_job_init(&job, MEMCOPY_OP_COPY, (UINTPTR)(src + SRC_OFF), (UINTPTR)(dst + DST_OFF), PKT_LEN);
+    if (run_job(&job) != 0)
+        return -1;
+
+    memcopy_ch_cache_invalidate(0, dst, buf_len);
+
+    for (uint32_t i = 0; i < PKT_LEN + 2 * DST_OFF; ++i) {
+        uint8_t expect = (i < DST_OFF || i >= DST_OFF + PKT_LEN) ? 0x5A : src[SRC_OFF + i - DST_OFF];
+        if (dst[i] != expect) {
+            xil_printf("Unaligned Mismatch at byte %u: expect=0x%02x dst=0x%02x\r\n",
+                       i, expect, dst[i]);
+            errors++;
+            if (errors > 10) break;
+        }
+    }
+
+    if (errors == 0) {
+        xil_printf("Unaligned test PASSED! (%u bytes, src+%u -> dst+%u)\r\n", PKT_LEN, SRC_OFF, DST_OFF);
+    } else {
+        xil_printf("Unaligned test FAILED with %d errors.\r\n", errors);
+    }
+    return errors;
+}
+
+/* Gather scattered fragments of src into one contiguous block of dst with a
+   single descriptor chain, then check it against the same copies by the CPU */
+static int run_sg_test(uint8_t *src, uint8_t *dst, uint32_t buf_len)
+{
+    static const struct { uint32_t src_off, len; } frags[] = {
+        { 0, 64 }, { 301, 333 }, { 1024, 1 }, { 77, 999 }, { 1800, 128 },
+    };
+    const uint32_t NUM_FRAGS = sizeof(frags) / sizeof(frags[0]);
+    static memcopy_desc_t desc[8];
+    memcopy_chain_t chain;
+    memcopy_job_t job;
+    uint32_t total = 0;
+    int errors = 0;
+
+    memset(dst, 0x5A, buf_len);
+    memcopy_ch_cache_flush(0, src, buf_len);
+    memcopy_ch_cache_flush(0, dst, buf_len);
+
+    memcopy_chain_init(&chain, desc, sizeof(desc) / sizeof(desc[0]));
+    for (uint32_t i = 0; i < NUM_FRAGS; ++i) {
+        memcopy_chain_add(&chain, (UINTPTR)(src + frags[i].src_off),
+                          (UINTPTR)(dst + total), frags[i].len);
+        total += frags[i].len;
+    }
+
+    memcopy_job_init(&job, MEMCOPY_OP_SG, 0, 0, 0);
+    job.chain = &chain;
+    if (run_job(&job) != 0)
+        return -1;
+
+    memcopy_ch_cache_invalidate(0, dst, buf_len);
+
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < NUM_FRAGS && errors <= 10; ++i) {
+        for (uint32_t j = 0; j < frags[i].len; ++j, ++pos) {
+            if (dst[pos] != src[frags[i].src_off + j]) {
+                xil_printf("SG Mismatch at byte %u (desc %u): expect=0x%02x dst=0x%02x\r\n",
+                           pos, i, src[frags[i].src_off + j], dst[pos]);
+                if (++errors > 10) break;
+            }
+        }
+    }
+    if (errors == 0 && dst[total] != 0x5A) {
+        xil_printf("SG overrun past byte %u\r\n", total);
+        errors++;
+    }
+
+    if (errors == 0) {
+        xil_printf("Scatter-gather test PASSED! (%u descriptors, %u bytes)\r\n", NUM_FRAGS, total);
+    } else {
+        xil_printf("Scatter-gather test FAILED with %d errors.\r\n", errors);
+    }
+    return errors;
+}
+
+/* Move a 16 x 100-byte tile from a 256-byte pitch to a 128-byte pitch with
+   one start; the bytes between destination rows must stay untouched */
+static int run_2d_test(uint8_t *src, uint8_t *dst, uint32_t buf_len)
+{
+    const uint32_t ROWS = 16, ROW_BYTES = 100, SRC_PITCH = 256, DST_PITCH = 128, DST_OFF = 5;
+    memcopy_job_t job;
+    int errors = 0;
+
+    memset(dst, 0x5A, buf_len);
+    memcopy_ch_cache_flush(0, src, buf_len);
+    memcopy_ch_cache_flush(0, dst, buf_len);
+
+    memcopy_job_init(&job, MEMCOPY_OP_2D, (UINTPTR)src, (UINTPTR)(dst + DST_OFF), 0);
+    job.rows = ROWS;
+    job.row_bytes = ROW_BYTES;
+    job.src_stride = SRC_PITCH;
+    job.dst_stride = DST_PITCH;
+    if (run_job(&job) != 0)
+        return -1;
+
+    memcopy_ch_cache_invalidate(0, dst, buf_len);
+
+    for (uint32_t i = 0; i < ROWS * DST_PITCH && errors <= 10; ++i) {
+        uint32_t r = i / DST_PITCH, c = i % DST_PITCH;
+        uint8_t expect = (c >= DST_OFF && c < DST_OFF + ROW_BYTES) ? src[r * SRC_PITCH + c - DST_OFF] : 0x5A;
+        if (dst[i] != expect) {
+            xil_printf("2D Mismatch at row %u col %u: expect=0x%02x dst=0x%02x\r\n",
+                       r, c, expect, dst[i]);
+            errors++;
+        }
+    }
+
+    if (errors == 0) {
+        xil_printf("2D test PASSED! (%u x %u bytes, pitch %u -> %u)\r\n", ROWS, ROW_BYTES, SRC_PITCH, DST_PITCH);
+    } else {
+        xil_printf("2D test FAILED with %d errors.\r\n", errors);
+    }
+    return errors;
+}
+
+/* Cached-buffer copy of len bytes: flush everything, copy, invalidate
+   everything, then the same split into CHUNK-byte pieces with the cache
+   maintenance overlapping the copies */
+static void run_chunked_bench(uint8_t *src, uint8_t *dst, uint32_t len)
+{
+    const uint32_t CHUNK = 8 * 1024;
+    memcopy_job_t job;
+    XTime t0, t1;
+    uint32_t us_serial, us_chunked;
+
+    XTime_GetTime(&t0);
+    memcopy_ch_cache_flush(0, src, len);
+    memcopy_ch_cache_flush(0, dst, len);
+    memcopy_job_init(&job, MEMCOPY_OP_COPY, (UINTPTR)src, (UINTPTR)dst, len);
+    if (run_job(&job) != 0)
+        return;
+    memcopy_ch_cache_invalidate(0, dst, len);
+    XTime_GetTime(&t1);
+    us_serial = (uint32_t)((t1 - t0) / (COUNTS_PER_SECOND / 1000000));
+
+    memset(dst, 0, len);
+    XTime_GetTime(&t0);
+    if (memcopy_ch_copy_chunked(0, dst, src, len, CHUNK) != 0) {
+        xil_printf("ERROR: Timeout in chunked copy\r\n");
+        return;
+    }
+    XTime_GetTime(&t1);
+    us_chunked = (uint32_t)((t1 - t0) / (COUNTS_PER_SECOND / 1000000));
+
+    xil_printf("%u bytes with cache maintenance: serial %u us, %u-byte chunks %u us, %s\r\n",
+               len, us_serial, CHUNK, us_chunked, memcmp(src, dst, len) ? "FAILED" : "PASSED");
+}
+
+/* Measure the CPU/accelerator crossover, print the table, then check
+   memcopy_auto() on one length either side of the threshold */
+static void run_auto_calibration(uint8_t *src, uint8_t *dst, uint32_t len)
+{
+    if (memcopy_auto_calibrate(src, dst, len) != 0) {
+        xil_printf("ERROR: Timeout during memcopy_auto calibration\r\n");
+        return;
+    }
+
+    const memcopy_auto_table_t *t = memcopy_auto_get_table();
+    xil_printf("memcopy_auto calibration (ns, best of 3):\r\n");
+    for (uint32_t i = 0; i < t->count; ++i)
+        xil_printf("  %6u bytes: cpu %6u accel %6u\r\n", t->point[i].len,
+                   (uint32_t)((uint64_t)t->point[i].cpu_ticks * 1000000000u / COUNTS_PER_SECOND),
+                   (uint32_t)((uint64_t)t->point[i].accel_ticks * 1000000000u / COUNTS_PER_SECOND));
+    if (t->threshold == UINT32_MAX)
+        xil_printf("  CPU is faster at every size\r\n");
+    else
+        xil_printf("  accelerator from %u bytes\r\n", t->threshold);
+
+    int errors = 0;
+    for (uint32_t i = 0; i < len / 2; ++i)
+        src[i] = (uint8_t)(i * 7u);
+    const uint32_t lens[] = { 100, t->threshold < len / 2 ? t->threshold + 3 : len / 2 - 1 };
+    for (uint32_t k = 0; k < 2; ++k) {
+        memset(dst, 0, lens[k] + 1);
+        if (memcopy_auto(dst, src, lens[k]) != 0 || memcmp(dst, src, lens[k]) != 0 || dst[lens[k]] != 0)
+            errors++;
+    }
+    xil_printf("memcopy_auto test %s\r\n", errors ? "FAILED" : "PASSED");
+}
+
 int main()
 {
 	XTime tStart, tEnd;
 
     xil_printf("\r\n--- Memcopy_accel robust demo (Zybo Z7-10) ---\r\n");
 
-    memcopy_accel_init(MEMCOPY_BASE);
+    for (uint32_t ch = 0; ch < NUM_CH; ++ch)
+        memcopy_ch_init(ch, ch_base[ch]);
 
     if (setup_interrupt_system() != XST_SUCCESS) {
         xil_printf("ERROR: Interrupt setup failed!\r\n");
@@ -131,50 +654,41 @@ int main()
     }
 
 
-    /* Initialize source with pattern */
-    for (uint32_t i = 0; i < NUM_WORDS; ++i) {
-        src_buf[i] = 0xA5A50000u | i;
-        dst_buf[i] = 0x0;
-        dst_buf_cpu[i] = 0x0;
+    /* Initialize source with pattern and clear the destinations in the PL
+       (write-only fill mode) instead of CPU loops */
+    uint32_t src_crc;   /* CRC of the pattern written to src */
+    if (fill_buffer(src_buf, BYTE_LEN, 0xA5A50000u, true, &src_crc) != 0) {
+        xil_printf("ERROR: buffer fill failed\r\n");
+        return -1;
+    }
+    if (fill_buffer(dst_buf, BYTE_LEN, 0x0, false, NULL) != 0 ||
+        fill_buffer(dst_buf_cpu, BYTE_LEN, 0x0, false, NULL) != 0) {
+        xil_printf("ERROR: buffer fill failed\r\n");
+        return -1;
     }
 
     xil_printf("Buffers: SRC=0x%08x, DST=0x%08x, len=%u bytes\r\n",
                (unsigned int)src_buf, (unsigned int)dst_buf, BYTE_LEN);
 
-    /* Cache maintenance before DMA */
-    Xil_DCacheFlushRange((unsigned int)src_buf, BYTE_LEN);
-    Xil_DCacheFlushRange((unsigned int)dst_buf, BYTE_LEN);
-
     xil_printf("Starting accelerator...\r\n");
+    memcopy_job_t copy;
+    memcopy_job_init(&copy, MEMCOPY_OP_COPY, (UINTPTR)src_buf, (UINTPTR)dst_buf, BYTE_LEN);
     XTime_GetTime(&tStart);
-    memcopy_done = 0;
-    memcopy_accel_start((uint32_t)src_buf, (uint32_t)dst_buf, BYTE_LEN);
-
-    /* WFI with Timeout Protection */
-    XTime tStartWFI, tNow;
-    XTime_GetTime(&tStartWFI);
-    const XTime TIMEOUT_VAL = (XTime)COUNTS_PER_SECOND * 2; // 2 seconds
-
-    do {
-        __asm__ volatile ("wfi");   // wakes on any IRQ
-        XTime_GetTime(&tNow);
-        if ((tNow - tStartWFI) > TIMEOUT_VAL) {
-            xil_printf("ERROR: Timeout waiting for accelerator interrupt!\r\n");
-            break;
-        }
-    } while (!memcopy_done);
-
+    run_job(&copy);
     XTime_GetTime(&tEnd);
     uint32_t time_accel = (uint32_t)((tEnd - tStart) / (COUNTS_PER_SECOND / 1000000));
 
     xil_printf("Accelerator finished in %d us\r\n", time_accel);
 
     /* Invalidate cache to read fresh data written by DMA */
-    Xil_DCacheInvalidateRange((unsigned int)dst_buf, BYTE_LEN);
+    memcopy_ch_cache_invalidate(0, dst_buf, BYTE_LEN);
 
-    /* Verify Accelerator result */
+    /* Verify Accelerator result: the copy's CRC must match the CRC the
+       pattern fill reported for src; only walk the buffer on a mismatch */
     int errors = 0;
-    for (uint32_t i = 0; i < NUM_WORDS; ++i) {
+    uint32_t copy_crc = copy.crc;
+    xil_printf("CRC: src=0x%08x copy=0x%08x\r\n", src_crc, copy_crc);
+    for (uint32_t i = 0; copy_crc != src_crc && i < NUM_WORDS; ++i) {
         if (dst_buf[i] != src_buf[i]) {
             xil_printf("Accel Mismatch at idx %u: src=0x%08x dst=0x%08x\r\n",
                        i, src_buf[i], dst_buf[i]);
@@ -183,36 +697,60 @@ int main()
         }
     }
 
-    if (errors == 0) {
+    if (copy_crc == src_crc) {
         xil_printf("Accelerator test PASSED!\r\n");
     } else {
-        xil_printf("Accelerator test FAILED with %d errors.\r\n", errors);
+        xil_printf("Accelerator test FAILED (CRC mismatch, %d word errors).\r\n", errors);
     }
 
+    /* Byte-exact copy between unaligned addresses (reuses dst_buf_cpu) */
+    run_unaligned_test((uint8_t *)src_buf, (uint8_t *)dst_buf_cpu, 2048);
+
+    /* Descriptor chain: several fragments in one start */
+    run_sg_test((uint8_t *)src_buf, (uint8_t *)dst_buf_cpu, 4096);
+
+    /* Strided tile: one start instead of one per row */
+    run_2d_test((uint8_t *)src_buf, (uint8_t *)dst_buf_cpu, 4096);
+
+    /* Back-to-back small jobs: ap_ctrl_chain queueing vs one at a time */
+    run_queue_bench((uint8_t *)src_buf, (uint8_t *)dst_buf_cpu);
+
+    /* Many jobs queued at once, CPU busy meanwhile */
+    run_async_test((uint8_t *)src_buf, (uint8_t *)dst_buf_cpu);
+
+    /* Commands through the DDR ring instead of register writes per job */
+    run_ring_test((uint8_t *)src_buf, (uint8_t *)dst_buf_cpu);
+
+    /* Independent copies on separate channels */
+    if (NUM_CH > 1)
+        run_multichannel_bench((uint8_t *)src_buf, (uint8_t *)dst_buf_cpu, BYTE_LEN / NUM_CH);
+
     /* CPU Memcopy Benchmark */
     XTime_GetTime(&tStart);
     cpu_memcopy(src_buf, dst_buf_cpu, BYTE_LEN);
     XTime_GetTime(&tEnd);
     uint32_t time_cpu = (uint32_t)((tEnd - tStart) / (COUNTS_PER_SECOND / 1000000));
 
-    /* Verify CPU result */
-    errors = 0;
-    for (uint32_t i = 0; i < NUM_WORDS; ++i) {
-        if (dst_buf_cpu[i] != src_buf[i]) {
-            xil_printf("CPU Mismatch at idx %u: src=0x%08x dst=0x%08x\r\n",
-                       i, src_buf[i], dst_buf_cpu[i]);
-            errors++;
-            if (errors > 10) break;
-        }
-    }
+    /* Verify CPU result with the hardware compare (write the copy back first) */
+    memcopy_ch_cache_flush(0, dst_buf_cpu, BYTE_LEN);
+    errors = hw_compare(src_buf, dst_buf_cpu, BYTE_LEN, "CPU copy");
 
     if (errors == 0) {
         xil_printf("CPU test PASSED!\r\n");
     }
 
+    /* Cache maintenance overlapped with the copy */
+    run_chunked_bench((uint8_t *)src_buf, (uint8_t *)dst_buf_cpu, BYTE_LEN);
+
+    /* CPU vs accelerator crossover for memcopy_auto() (dst_buf and
+       dst_buf_cpu are scratch from here on) */
+    run_auto_calibration((uint8_t *)dst_buf, (uint8_t *)dst_buf_cpu, BYTE_LEN);
+
     xil_printf("\r------------------------------------------\r\n\n");
     xil_printf("CPU memcpy done in %d us\r\n", time_cpu);
     xil_printf("Accelerator memcpy done in %d us\r\n", time_accel);
+    xil_printf("Accelerator counters: %u cycles, %u read beats, %u write beats, %u stall cycles\r\n",
+               copy.perf.cycles, copy.perf.rd_beats, copy.perf.wr_beats, copy.perf.stall);
 
     free(src_buf);
     free(dst_buf);
@@ -1,61 +1,826 @@
+#include <string.h>
+#include <stdatomic.h>
 #include "memcopy_accel.h"
 #include "xil_io.h"
+#include "xil_cache.h"
+#include "xil_exception.h"
 #include "xil_printf.h"
+#include "xiltimer.h"
+#include "xmemcopy_accel_hw.h"
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
-static uint32_t base_addr = MEMCOPY_ACCEL_BASEADDR;
+/* The hand-written offsets must match the generated register map */
+_Static_assert(MEMCOPY_ACCEL_SRC_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_SRC_DATA, "src offset");
+_Static_assert(MEMCOPY_ACCEL_DST_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_DATA, "dst offset");
+_Static_assert(MEMCOPY_ACCEL_LEN_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_LEN_DATA, "len offset");
+_Static_assert(MEMCOPY_ACCEL_SRC_OFF_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_SRC_OFF_DATA, "src_off offset");
+_Static_assert(MEMCOPY_ACCEL_DST_OFF_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_OFF_DATA, "dst_off offset");
+_Static_assert(MEMCOPY_ACCEL_DST_BYTES_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_BYTES_DATA, "dst_bytes offset");
+_Static_assert(MEMCOPY_ACCEL_OP_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_OP_DATA, "op offset");
+_Static_assert(MEMCOPY_ACCEL_DESC_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DESC_DATA, "desc offset");
+_Static_assert(MEMCOPY_ACCEL_ROWS_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_ROWS_DATA, "rows offset");
+_Static_assert(MEMCOPY_ACCEL_ROW_BYTES_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_ROW_BYTES_DATA, "row_bytes offset");
+_Static_assert(MEMCOPY_ACCEL_SRC_STRIDE_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_SRC_STRIDE_DATA, "src_stride offset");
+_Static_assert(MEMCOPY_ACCEL_DST_STRIDE_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_STRIDE_DATA, "dst_stride offset");
+_Static_assert(MEMCOPY_ACCEL_FILL_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_FILL_DATA, "fill offset");
+_Static_assert(MEMCOPY_ACCEL_CRC_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CRC_DATA, "crc offset");
+_Static_assert(MEMCOPY_ACCEL_CRC_CTRL_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CRC_CTRL, "crc ctrl offset");
+_Static_assert(MEMCOPY_ACCEL_CMP_MATCH_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_MATCH_DATA, "cmp_match offset");
+_Static_assert(MEMCOPY_ACCEL_CMP_FIRST_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_FIRST_DATA, "cmp_first offset");
+_Static_assert(MEMCOPY_ACCEL_CMP_COUNT_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_COUNT_DATA, "cmp_count offset");
+_Static_assert(MEMCOPY_ACCEL_PERF_CYCLES_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_CYCLES_DATA, "perf_cycles offset");
+_Static_assert(MEMCOPY_ACCEL_PERF_RD_BEATS_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_RD_BEATS_DATA, "perf_rd_beats offset");
+_Static_assert(MEMCOPY_ACCEL_PERF_WR_BEATS_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_WR_BEATS_DATA, "perf_wr_beats offset");
+_Static_assert(MEMCOPY_ACCEL_PERF_STALL_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_STALL_DATA, "perf_stall offset");
+_Static_assert(MEMCOPY_ACCEL_CPL_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CPL_DATA, "cpl offset");
+_Static_assert(MEMCOPY_ACCEL_RING_PROD_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_RING_PROD_DATA, "ring_prod offset");
+_Static_assert(MEMCOPY_ACCEL_IRQ_COUNT_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_IRQ_COUNT_DATA, "irq_count offset");
+_Static_assert(MEMCOPY_ACCEL_IRQ_IDLE_OFFSET == XMEMCOPY_ACCEL_CTRL_BUS_ADDR_IRQ_IDLE_DATA, "irq_idle offset");
 
-void memcopy_accel_init(uint32_t baseaddr)
+/* Per-channel state: each channel is one IP instance */
+static struct {
+    uintptr_t base;
+    uint32_t auto_restart;  /* shadow of AP_CTRL bit 7 */
+    bool coherent;          /* masters on the ACP: no cache maintenance */
+} chan[MEMCOPY_ACCEL_NUM_CHANNELS] = { { MEMCOPY_ACCEL_BASEADDR, 0, MEMCOPY_ACCEL_COHERENT } };
+
+/* Per-channel job queue, lock-free with one producer (memcopy_submit) and
+   one consumer (memcopy_ch_irq). Free-running indices: jobs [head, issued)
+   are in the IP, [issued, tail) wait for it. tail is only written by the
+   producer and head by the ISR; issued by whichever context holds pumping.
+   Each stats counter also has a single writer. */
+_Static_assert((MEMCOPY_JOB_QUEUE_DEPTH & (MEMCOPY_JOB_QUEUE_DEPTH - 1u)) == 0, "job queue depth");
+_Static_assert(MEMCOPY_ACCEL_NUM_CHANNELS <= 8u, "channel does not fit in a ticket");
+
+static struct {
+    memcopy_job_t *job[MEMCOPY_JOB_QUEUE_DEPTH];
+    atomic_uint head;           /* jobs completed */
+    atomic_uint issued;         /* jobs started */
+    atomic_uint tail;           /* jobs submitted */
+    atomic_flag pumping;        /* a context is starting jobs */
+    atomic_uint repump;         /* the ISR found pumping set */
+    memcopy_queue_stats_t stats;
+} jobq[MEMCOPY_ACCEL_NUM_CHANNELS];
+
+/* Set ap_start, keeping auto_restart. AP_CTRL is not read back because
+   that would clear a pending ap_done (COR). */
+static void memcopy_ch_kick(uint32_t ch)
+{
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_CTRL_OFFSET, chan[ch].auto_restart | MEMCOPY_AP_START_MASK);
+}
+
+/* 64-bit argument: low word, then high word */
+static void memcopy_ch_out64(uint32_t ch, uint32_t offset, uint64_t value)
+{
+    Xil_Out32(chan[ch].base + offset, (uint32_t)value);
+    Xil_Out32(chan[ch].base + offset + 0x04, (uint32_t)(value >> 32));
+}
+
+static uint64_t memcopy_ch_in64(uint32_t ch, uint32_t offset)
+{
+    return Xil_In32(chan[ch].base + offset) | (uint64_t)Xil_In32(chan[ch].base + offset + 0x04) << 32;
+}
+
+void memcopy_ch_init(uint32_t ch, uintptr_t baseaddr)
 {
-    base_addr = baseaddr;
+    chan[ch].base = baseaddr;
+    chan[ch].auto_restart = 0;
+    chan[ch].coherent = MEMCOPY_ACCEL_COHERENT;
 }
 
-void memcopy_accel_start(uint32_t src_addr, uint32_t dst_addr, uint32_t len)
+/* The channel's masters go through the ACP (IP built with the coherent
+   AxCACHE/AxUSER values): the SCU snoops the L1 and the transactions
+   allocate in the L2, so the cache calls below do nothing */
+void memcopy_ch_set_coherent(uint32_t ch, bool enable)
 {
+    chan[ch].coherent = enable;
+}
+
+bool memcopy_ch_is_coherent(uint32_t ch)
+{
+    return chan[ch].coherent;
+}
+
+/* Write back len bytes at buf before the channel reads them (or writes
+   over them: no dirty line may be evicted over the result later) */
+void memcopy_ch_cache_flush(uint32_t ch, const void *buf, size_t len)
+{
+    if (!chan[ch].coherent)
+        Xil_DCacheFlushRange((UINTPTR)buf, (u32)len);
+}
+
+/* Drop the stale lines of len bytes at buf after the channel wrote them */
+void memcopy_ch_cache_invalidate(uint32_t ch, void *buf, size_t len)
+{
+    if (!chan[ch].coherent)
+        Xil_DCacheInvalidateRange((UINTPTR)buf, (u32)len);
+}
+
+void memcopy_ch_start(uint32_t ch, uint64_t src_addr, uint64_t dst_addr, uint64_t len)
+{
+    memcopy_ch_start_transform(ch, src_addr, dst_addr, len, MEMCOPY_OP_COPY);
+}
+
+/* Copy with an inline transform (MEMCOPY_OP_SWAP* / MEMCOPY_OP_WIDEN*, or
+   MEMCOPY_OP_COPY). len is the source length; widening writes 2x/4x. */
+void memcopy_ch_start_transform(uint32_t ch, uint64_t src_addr, uint64_t dst_addr, uint64_t len, uint32_t op)
+{
+    /* Any byte address and length: the IP takes bus-aligned bases plus the
+       byte offset of the first byte, and strobes the partial head/tail beats */
+    uint64_t src_base = src_addr & ~(uint64_t)(MEMCOPY_ACCEL_BUS_BYTES - 1u);
+    uint64_t dst_base = dst_addr & ~(uint64_t)(MEMCOPY_ACCEL_BUS_BYTES - 1u);
+
     /* Write parameters */
-    Xil_Out32(base_addr + MEMCOPY_ACCEL_SRC_OFFSET, src_addr);
-    Xil_Out32(base_addr + MEMCOPY_ACCEL_SRC_OFFSET + 0x04, 0x00000000u); // src high
-    Xil_Out32(base_addr + MEMCOPY_ACCEL_DST_OFFSET, dst_addr);
-    Xil_Out32(base_addr + MEMCOPY_ACCEL_DST_OFFSET + 0x04, 0x00000000u); // dst high
-    Xil_Out32(base_addr + MEMCOPY_ACCEL_LEN_OFFSET, len);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_SRC_OFFSET, src_base);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_DST_OFFSET, dst_base);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_LEN_OFFSET, len);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_SRC_OFF_OFFSET, (uint32_t)(src_addr - src_base));
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_DST_OFF_OFFSET, (uint32_t)(dst_addr - dst_base));
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_DST_BYTES_OFFSET, dst_base);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_OP_OFFSET, op);
     /* Start IP (write ap_start = 1) */
-    Xil_Out32(base_addr + MEMCOPY_ACCEL_CTRL_OFFSET, MEMCOPY_AP_START_MASK);
+    memcopy_ch_kick(ch);
+}
+
+void memcopy_ch_start_2d(uint32_t ch, uint64_t src_addr, uint64_t dst_addr, uint32_t rows,
+                         uint32_t row_bytes, uint32_t src_stride, uint32_t dst_stride)
+{
+    /* Row r is row_bytes at src_addr + r * src_stride -> dst_addr + r * dst_stride */
+    uint64_t src_base = src_addr & ~(uint64_t)(MEMCOPY_ACCEL_BUS_BYTES - 1u);
+    uint64_t dst_base = dst_addr & ~(uint64_t)(MEMCOPY_ACCEL_BUS_BYTES - 1u);
+
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_SRC_OFFSET, src_base);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_DST_OFFSET, dst_base);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_SRC_OFF_OFFSET, (uint32_t)(src_addr - src_base));
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_DST_OFF_OFFSET, (uint32_t)(dst_addr - dst_base));
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_DST_BYTES_OFFSET, dst_base);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_ROWS_OFFSET, rows);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_ROW_BYTES_OFFSET, row_bytes);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_SRC_STRIDE_OFFSET, src_stride);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_DST_STRIDE_OFFSET, dst_stride);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_OP_OFFSET, MEMCOPY_OP_2D);
+    memcopy_ch_kick(ch);
+}
+
+void memcopy_ch_start_fill(uint32_t ch, uint64_t dst_addr, uint64_t len, uint32_t value, bool incr)
+{
+    /* Write-only: word i of the region is value, or value + i with incr */
+    uint64_t dst_base = dst_addr & ~(uint64_t)(MEMCOPY_ACCEL_BUS_BYTES - 1u);
+
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_DST_OFFSET, dst_base);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_LEN_OFFSET, len);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_DST_OFF_OFFSET, (uint32_t)(dst_addr - dst_base));
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_DST_BYTES_OFFSET, dst_base);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_FILL_OFFSET, value);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_OP_OFFSET, incr ? MEMCOPY_OP_PATTERN : MEMCOPY_OP_FILL);
+    memcopy_ch_kick(ch);
 }
 
-bool memcopy_accel_is_done(void)
+bool memcopy_ch_is_done(uint32_t ch)
 {
-    uint32_t ctrl = Xil_In32(base_addr + MEMCOPY_ACCEL_CTRL_OFFSET);
+    uint32_t ctrl = Xil_In32(chan[ch].base + MEMCOPY_ACCEL_CTRL_OFFSET);
     return (ctrl & MEMCOPY_AP_DONE_MASK) != 0;
 }
 
-void memcopy_accel_wait_done(void)
+/* CRC-32 (zlib crc32() convention) of every byte the last run wrote, in
+   write order: the chain for SG, all rows for 2D, the pattern for fills.
+   Valid once the run is done. */
+uint32_t memcopy_ch_get_crc(uint32_t ch)
+{
+    return Xil_In32(chan[ch].base + MEMCOPY_ACCEL_CRC_OFFSET);
+}
+
+/* Hardware memcmp of len bytes at a_addr and b_addr (any alignment). Both
+   are only read, so flush them from the cache first. */
+void memcopy_ch_start_compare(uint32_t ch, uint64_t a_addr, uint64_t b_addr, uint64_t len)
+{
+    uint64_t a_base = a_addr & ~(uint64_t)(MEMCOPY_ACCEL_BUS_BYTES - 1u);
+    uint64_t b_base = b_addr & ~(uint64_t)(MEMCOPY_ACCEL_BUS_BYTES - 1u);
+
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_SRC_OFFSET, a_base);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_DST_OFFSET, b_base);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_LEN_OFFSET, len);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_SRC_OFF_OFFSET, (uint32_t)(a_addr - a_base));
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_DST_OFF_OFFSET, (uint32_t)(b_addr - b_base));
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_OP_OFFSET, MEMCOPY_OP_CMP);
+    memcopy_ch_kick(ch);
+}
+
+/* Result of the last compare: true if equal. first/count (may be NULL)
+   get the offset of the first differing byte and the number of them. */
+bool memcopy_ch_get_compare(uint32_t ch, uint64_t *first, uint64_t *count)
+{
+    if (first)
+        *first = memcopy_ch_in64(ch, MEMCOPY_ACCEL_CMP_FIRST_OFFSET);
+    if (count)
+        *count = memcopy_ch_in64(ch, MEMCOPY_ACCEL_CMP_COUNT_OFFSET);
+    return Xil_In32(chan[ch].base + MEMCOPY_ACCEL_CMP_MATCH_OFFSET) != 0;
+}
+
+/* Counters of the last finished run (a queued job overwrites them when
+   it completes). cycles is in the PL clock of the IP. */
+void memcopy_ch_get_perf(uint32_t ch, memcopy_perf_t *perf)
+{
+    perf->cycles = Xil_In32(chan[ch].base + MEMCOPY_ACCEL_PERF_CYCLES_OFFSET);
+    perf->rd_beats = Xil_In32(chan[ch].base + MEMCOPY_ACCEL_PERF_RD_BEATS_OFFSET);
+    perf->wr_beats = Xil_In32(chan[ch].base + MEMCOPY_ACCEL_PERF_WR_BEATS_OFFSET);
+    perf->stall = Xil_In32(chan[ch].base + MEMCOPY_ACCEL_PERF_STALL_OFFSET);
+}
+
+/* The IP has latched the arguments (ap_start cleared on ap_ready): the
+   registers may be written for the next job and ap_start set again while
+   this one drains (ap_ctrl_chain). Reads AP_CTRL, so with ap_ctrl_hs it
+   clears a pending ap_done: do not mix it with memcopy_ch_is_done() there. */
+bool memcopy_ch_is_ready(uint32_t ch)
+{
+    return (Xil_In32(chan[ch].base + MEMCOPY_ACCEL_CTRL_OFFSET) & MEMCOPY_AP_START_MASK) == 0;
+}
+
+/* Acknowledge ap_done. With ap_ctrl_chain the IP holds each job's ap_done
+   until this is written; with ap_ctrl_hs bit 4 is reserved and ignored. */
+void memcopy_ch_continue(uint32_t ch)
+{
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_CTRL_OFFSET, chan[ch].auto_restart | MEMCOPY_AP_CONTINUE_MASK);
+}
+
+/* auto_restart: the IP reruns the last job as soon as it is continued */
+void memcopy_ch_set_auto_restart(uint32_t ch, bool enable)
+{
+    chan[ch].auto_restart = enable ? MEMCOPY_AUTO_RESTART_MASK : 0u;
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_CTRL_OFFSET, chan[ch].auto_restart);
+}
+
+void memcopy_ch_wait_done(uint32_t ch)
+{
+    /* Poll ap_done (clear on read), then release the IP for the next job */
+    while (!memcopy_ch_is_done(ch)) { /* busy wait */ }
+    memcopy_ch_continue(ch);
+}
+
+void memcopy_chain_init(memcopy_chain_t *chain, memcopy_desc_t *desc, uint32_t max)
+{
+    chain->desc = desc;
+    chain->count = 0;
+    chain->max = max;
+}
+
+int memcopy_chain_add(memcopy_chain_t *chain, uint64_t src_addr, uint64_t dst_addr, uint64_t len)
+{
+    /* A descriptor holds a 32-bit length: longer fragments take several */
+    uint64_t n = (len + MEMCOPY_DESC_MAX_LEN - 1u) / MEMCOPY_DESC_MAX_LEN;
+    if (n == 0)
+        n = 1;
+    if (n > chain->max - chain->count)
+        return -1;
+
+    do {
+        uint32_t part = len < MEMCOPY_DESC_MAX_LEN ? (uint32_t)len : MEMCOPY_DESC_MAX_LEN;
+        memcopy_desc_t *d = &chain->desc[chain->count++];
+        d->src = src_addr;
+        d->dst = dst_addr;
+        d->len = part;
+        d->flags = 0;
+        d->cookie = 0;
+        src_addr += part;
+        dst_addr += part;
+        len -= part;
+    } while (len != 0);
+    return 0;
+}
+
+void memcopy_ch_chain_submit(uint32_t ch, memcopy_chain_t *chain)
+{
+    if (chain->count == 0)
+        return;
+
+    chain->desc[chain->count - 1].flags |= MEMCOPY_DESC_LAST;
+    memcopy_ch_cache_flush(ch, chain->desc, chain->count * sizeof(memcopy_desc_t));
+
+    /* Descriptor addresses are absolute: zero bases for src/dst */
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_SRC_OFFSET, 0u);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_DST_OFFSET, 0u);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_DST_BYTES_OFFSET, 0u);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_LEN_OFFSET, chain->count);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_OP_OFFSET, MEMCOPY_OP_SG);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_DESC_OFFSET, (UINTPTR)chain->desc);
+    memcopy_ch_kick(ch);
+}
+
+/* Zero the completion ring and the producer index, point the IP at them and
+   start it with auto_restart. cmd must hold slots entries, cpl slots + 1. */
+int memcopy_ring_start(memcopy_ring_t *ring, uint32_t ch, memcopy_desc_t *cmd, memcopy_cpl_t *cpl,
+                       uint32_t slots, uint32_t irq_count, uint32_t irq_idle)
+{
+    if (slots == 0 || (slots & (slots - 1)) != 0)
+        return -1;
+
+    ring->cmd = cmd;
+    ring->cpl = cpl;
+    ring->slots = slots;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->ch = ch;
+    ring->prod[0] = 0;
+    memset(cpl, 0, (slots + 1) * sizeof(memcopy_cpl_t));
+    memcopy_ch_cache_flush(ch, (const void *)ring->prod, sizeof(ring->prod));
+    memcopy_ch_cache_flush(ch, cpl, (slots + 1) * sizeof(memcopy_cpl_t));
+
+    /* Command addresses are absolute: zero bases for src/dst */
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_SRC_OFFSET, 0u);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_DST_OFFSET, 0u);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_DST_BYTES_OFFSET, 0u);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_DESC_OFFSET, (UINTPTR)cmd);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_CPL_OFFSET, (UINTPTR)cpl);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_RING_PROD_OFFSET, (UINTPTR)ring->prod);
+    memcopy_ch_out64(ch, MEMCOPY_ACCEL_LEN_OFFSET, slots);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_IRQ_COUNT_OFFSET, irq_count);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_IRQ_IDLE_OFFSET, irq_idle);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_OP_OFFSET, MEMCOPY_OP_RING);
+    chan[ch].auto_restart = MEMCOPY_AUTO_RESTART_MASK;
+    memcopy_ch_kick(ch);
+    return 0;
+}
+
+static int memcopy_ring_put(memcopy_ring_t *ring, uint64_t src_addr, uint64_t dst_addr, uint32_t len,
+                            uint32_t flags, uint64_t cookie)
+{
+    if (ring->head - ring->tail >= ring->slots)
+        return -1;
+
+    memcopy_desc_t *d = &ring->cmd[ring->head & (ring->slots - 1)];
+    d->src = src_addr;
+    d->dst = dst_addr;
+    d->len = len;
+    d->flags = flags;
+    d->cookie = cookie;
+    memcopy_ch_cache_flush(ring->ch, d, sizeof(*d));
+    ring->head++;
+    return 0;
+}
+
+/* Write one command slot; the IP does not see it before the doorbell.
+   Returns -1 if all slots hold commands whose completions are not reaped. */
+int memcopy_ring_add(memcopy_ring_t *ring, uint64_t src_addr, uint64_t dst_addr, uint32_t len, uint64_t cookie)
+{
+    return memcopy_ring_put(ring, src_addr, dst_addr, len, 0, cookie);
+}
+
+/* Publish every added command: one store to the producer index */
+void memcopy_ring_doorbell(memcopy_ring_t *ring)
+{
+    ring->prod[0] = ring->head;
+    memcopy_ch_cache_flush(ring->ch, (const void *)ring->prod, sizeof(ring->prod));
+}
+
+/* Copy out the next completion if the IP has written it */
+bool memcopy_ring_reap(memcopy_ring_t *ring, memcopy_cpl_t *cpl)
+{
+    memcopy_cpl_t *c = &ring->cpl[1 + (ring->tail & (ring->slots - 1))];
+
+    memcopy_ch_cache_invalidate(ring->ch, c, sizeof(*c));
+    if (c->seq != ring->tail + 1)
+        return false;
+    /* The stop command's run started with auto_restart set, so one more
+       (empty) run follows it. Hand out the stop completion once that is
+       over and ap_idle is up (it needs ap_start low), so the channel is
+       free for the next job. */
+    if ((c->status & MEMCOPY_CPL_STOP) &&
+        !(Xil_In32(chan[ring->ch].base + MEMCOPY_ACCEL_CTRL_OFFSET) & MEMCOPY_AP_IDLE_MASK))
+        return false;
+    *cpl = *c;
+    ring->tail++;
+    return true;
+}
+
+/* Let the IP go idle: drop auto_restart, then queue a zero-length stop
+   command. Its completion (MEMCOPY_CPL_STOP) is the last one. */
+int memcopy_ring_stop(memcopy_ring_t *ring)
+{
+    if (ring->head - ring->tail >= ring->slots)
+        return -1;
+    memcopy_ch_set_auto_restart(ring->ch, false);
+    memcopy_ring_put(ring, 0, 0, 0, MEMCOPY_DESC_STOP, 0);
+    memcopy_ring_doorbell(ring);
+    return 0;
+}
+
+void memcopy_job_init(memcopy_job_t *job, uint32_t op, uint64_t src_addr, uint64_t dst_addr, uint64_t len)
+{
+    memset(job, 0, sizeof(*job));
+    job->op = op;
+    job->src = src_addr;
+    job->dst = dst_addr;
+    job->len = len;
+}
+
+static void memcopy_job_issue(uint32_t ch, memcopy_job_t *job)
+{
+    switch (job->op) {
+    case MEMCOPY_OP_SG:
+        memcopy_ch_chain_submit(ch, job->chain);
+        break;
+    case MEMCOPY_OP_2D:
+        memcopy_ch_start_2d(ch, job->src, job->dst, job->rows, job->row_bytes,
+                            job->src_stride, job->dst_stride);
+        break;
+    case MEMCOPY_OP_FILL:
+    case MEMCOPY_OP_PATTERN:
+        memcopy_ch_start_fill(ch, job->dst, job->len, job->fill, job->op == MEMCOPY_OP_PATTERN);
+        break;
+    case MEMCOPY_OP_CMP:
+        memcopy_ch_start_compare(ch, job->src, job->dst, job->len);
+        break;
+    default:
+        memcopy_ch_start_transform(ch, job->src, job->dst, job->len, job->op);
+        break;
+    }
+}
+
+/* The IP can take another job with in_ip of the queue's jobs in it. An
+   idle IP always can. With ap_ctrl_chain a second job can once the first
+   was latched, which only AP_CTRL tells; ap_done is held until
+   ap_continue there, so the read loses nothing. With ap_ctrl_hs AP_CTRL
+   is not read, since that would clear a pending ap_done (COR) that a
+   memcopy_ch_is_done() caller is waiting for: one job at a time. */
+static bool memcopy_ch_can_issue(uint32_t ch, uint32_t in_ip)
+{
+    if (in_ip == 0)
+        return true;
+#if MEMCOPY_ACCEL_CTRL_CHAIN
+    return in_ip < 2u && memcopy_ch_is_ready(ch);
+#else
+    (void)ch;
+    return false;
+#endif
+}
+
+/* Start waiting jobs while the IP takes them: with ap_ctrl_chain one job
+   runs and the next is latched, so at most two are in the IP. Called by
+   the producer after publishing a job and by the ISR after a completion.
+   If the ISR interrupts the producer inside this, it leaves the work to
+   it: the producer looks again after dropping pumping. */
+static void memcopy_job_pump(uint32_t ch, bool from_irq)
+{
+    for (;;) {
+        if (atomic_flag_test_and_set_explicit(&jobq[ch].pumping, memory_order_acquire)) {
+            atomic_store_explicit(&jobq[ch].repump, 1u, memory_order_relaxed);
+            return;
+        }
+        atomic_store_explicit(&jobq[ch].repump, 0u, memory_order_relaxed);
+
+        uint32_t issued = atomic_load_explicit(&jobq[ch].issued, memory_order_relaxed);
+        while (issued != atomic_load_explicit(&jobq[ch].tail, memory_order_acquire) &&
+               memcopy_ch_can_issue(ch, issued - atomic_load_explicit(&jobq[ch].head, memory_order_acquire))) {
+            memcopy_job_t *job = jobq[ch].job[issued & (MEMCOPY_JOB_QUEUE_DEPTH - 1u)];
+            /* count it before ap_start, so its ap_done always finds it */
+            atomic_store_explicit(&jobq[ch].issued, ++issued, memory_order_release);
+            memcopy_job_issue(ch, job);
+            if (from_irq)
+                jobq[ch].stats.started_chained++;
+            else
+                jobq[ch].stats.started_direct++;
+        }
+
+        atomic_flag_clear_explicit(&jobq[ch].pumping, memory_order_release);
+        if (!atomic_load_explicit(&jobq[ch].repump, memory_order_relaxed))
+            return;
+    }
+}
+
+/* Queue a job and start it if the channel is free. Returns its ticket, or
+   MEMCOPY_TICKET_NONE if the queue is full or the job cannot complete.
+   Single producer: call from one context per channel. */
+memcopy_ticket_t memcopy_submit(uint32_t ch, memcopy_job_t *job)
+{
+    if (job->op == MEMCOPY_OP_RING || (job->op == MEMCOPY_OP_SG && (!job->chain || job->chain->count == 0)))
+        return MEMCOPY_TICKET_NONE;
+
+    uint32_t tail = atomic_load_explicit(&jobq[ch].tail, memory_order_relaxed);
+    uint32_t depth = tail - atomic_load_explicit(&jobq[ch].head, memory_order_acquire);
+    if (depth >= MEMCOPY_JOB_QUEUE_DEPTH) {
+        jobq[ch].stats.rejected++;
+        return MEMCOPY_TICKET_NONE;
+    }
+
+    job->done = 0;
+    jobq[ch].job[tail & (MEMCOPY_JOB_QUEUE_DEPTH - 1u)] = job;
+    atomic_store_explicit(&jobq[ch].tail, tail + 1u, memory_order_release);
+    jobq[ch].stats.submitted++;
+    if (depth + 1u > jobq[ch].stats.high_water)
+        jobq[ch].stats.high_water = depth + 1u;
+
+    memcopy_job_pump(ch, false);
+    /* done once head reaches tail + 1; MEMCOPY_TICKET_VALID keeps a
+       sequence that wraps to 0 from reading as MEMCOPY_TICKET_NONE */
+    return ((tail + 1u) << 4) | MEMCOPY_TICKET_VALID | ch;
+}
+
+bool memcopy_ticket_done(memcopy_ticket_t ticket)
+{
+    uint32_t ch = ticket & 7u;
+    uint32_t head = atomic_load_explicit(&jobq[ch].head, memory_order_acquire);
+    /* sequences compare modulo 2^28 */
+    return (int32_t)((head << 4) - (ticket & ~15u)) >= 0;
+}
+
+void memcopy_ch_get_queue_stats(uint32_t ch, memcopy_queue_stats_t *stats)
+{
+    *stats = jobq[ch].stats;
+    stats->depth = atomic_load_explicit(&jobq[ch].tail, memory_order_relaxed) -
+                   atomic_load_explicit(&jobq[ch].head, memory_order_relaxed);
+}
+
+/* Only while the channel has no jobs: the counters belong to both contexts */
+void memcopy_ch_reset_queue_stats(uint32_t ch)
+{
+    memset(&jobq[ch].stats, 0, sizeof(jobq[ch].stats));
+}
+
+/* Sleep until the ticket's job is done. Returns 0, or -1 after timeout_us.
+   Call with IRQs enabled. */
+int memcopy_wait(memcopy_ticket_t ticket, uint32_t timeout_us)
+{
+    uint32_t ch = ticket & 7u;
+    XTime t0, now;
+
+    if (ticket == MEMCOPY_TICKET_NONE)
+        return -1;
+    XTime_GetTime(&t0);
+    for (;;) {
+        /* IRQ masked from the check to the wfi: an ap_done in between stays
+           pending and wakes the wfi instead of being taken before it. Only
+           sleep if the channel's ap_done interrupt is enabled; otherwise
+           nothing may come to wake the wfi and the timeout would not hold. */
+        Xil_ExceptionDisable();
+        if (memcopy_ticket_done(ticket)) {
+            Xil_ExceptionEnable();
+            return 0;
+        }
+        if ((Xil_In32(chan[ch].base + MEMCOPY_ACCEL_GIE_OFFSET) & MEMCOPY_GIE_ENABLE_MASK) &&
+            (Xil_In32(chan[ch].base + MEMCOPY_ACCEL_IER_OFFSET) & MEMCOPY_IER_CHAN0_INT_EN_MASK))
+            __asm__ volatile ("wfi");   // a pending IRQ wakes it even while masked
+        Xil_ExceptionEnable();
+        XTime_GetTime(&now);
+        if (now - t0 > (XTime)timeout_us * (COUNTS_PER_SECOND / 1000000))
+            return memcopy_ticket_done(ticket) ? 0 : -1;
+    }
+}
+
+/* Interrupt work for channel ch, to be called from its handler instead of
+   clear + continue. The results of the oldest job are read before ap_done
+   is acknowledged, then the next job is started and the callback runs.
+   Returns the finished job, or NULL for a run not started by
+   memcopy_submit() (start calls, ring, auto_restart). */
+memcopy_job_t *memcopy_ch_irq(uint32_t ch)
+{
+    memcopy_job_t *job = NULL;
+
+    memcopy_ch_interrupt_clear(ch);
+    // Read-back to flush AXI write and avoid IRQ retrigger (required on Zynq)
+    (void)Xil_In32(chan[ch].base + MEMCOPY_ACCEL_ISR_OFFSET);
+
+    uint32_t head = atomic_load_explicit(&jobq[ch].head, memory_order_relaxed);
+    if (head != atomic_load_explicit(&jobq[ch].issued, memory_order_acquire)) {
+        job = jobq[ch].job[head & (MEMCOPY_JOB_QUEUE_DEPTH - 1u)];
+        job->crc = memcopy_ch_get_crc(ch);
+        if (job->op == MEMCOPY_OP_CMP)
+            job->cmp_match = memcopy_ch_get_compare(ch, &job->cmp_first, &job->cmp_count);
+        memcopy_ch_get_perf(ch, &job->perf);
+    }
+
+    // ap_ctrl_chain holds ap_done until it is acknowledged
+    memcopy_ch_continue(ch);
+
+    if (job) {
+        atomic_store_explicit(&jobq[ch].head, head + 1u, memory_order_release);
+        jobq[ch].stats.completed++;
+    }
+
+    // Keep the IP busy: start the next job before the callback runs
+    memcopy_job_pump(ch, true);
+
+    if (job) {
+        job->done = 1;
+        if (job->cb)
+            job->cb(job, job->arg);
+    }
+    return job;
+}
+
+/* One chunk of a chunked copy */
+typedef struct {
+    memcopy_job_t job;
+    memcopy_ticket_t ticket;    /* MEMCOPY_TICKET_NONE once retired */
+    size_t off;
+    size_t len;
+} memcopy_chunk_t;
+
+/* Chunks n - 1, n, n + 1 of each channel. Static, not on the caller's
+   stack: a chunk that times out is still in the queue or the IP, and
+   memcopy_ch_irq() writes its results whenever it finishes. */
+static memcopy_chunk_t chunk_rec[MEMCOPY_ACCEL_NUM_CHANNELS][3];
+
+/* Take the chunk at *next, ending on a dst cache-line boundary (or at len),
+   write back its src and dst lines and queue its copy */
+static int memcopy_chunk_queue(uint32_t ch, memcopy_chunk_t *c, UINTPTR dst, UINTPTR src,
+                               size_t *next, size_t len, uint32_t chunk)
+{
+    size_t end = (size_t)(((dst + *next + chunk) & ~(UINTPTR)(MEMCOPY_CACHE_LINE - 1u)) - dst);
+    if (end > len || len - end < MEMCOPY_CACHE_LINE)
+        end = len;
+
+    c->off = *next;
+    c->len = end - *next;
+    memcopy_ch_cache_flush(ch, (const void *)(src + c->off), c->len);
+    memcopy_ch_cache_flush(ch, (const void *)(dst + c->off), c->len);
+    memcopy_job_init(&c->job, MEMCOPY_OP_COPY, src + c->off, dst + c->off, c->len);
+    c->ticket = memcopy_submit(ch, &c->job);
+    if (c->ticket == MEMCOPY_TICKET_NONE)
+        return -1;
+    *next = end;
+    return 0;
+}
+
+/* Wait for every chunk of ch still queued or in the IP. Returns 0, or -1
+   if one did not finish in time; its record then stays claimed. */
+static int memcopy_chunk_drain(uint32_t ch)
+{
+    int ret = 0;
+
+    for (uint32_t i = 0; i < 3u; ++i) {
+        memcopy_chunk_t *c = &chunk_rec[ch][i];
+
+        if (c->ticket == MEMCOPY_TICKET_NONE)
+            continue;
+        if (memcopy_wait(c->ticket, MEMCOPY_CHUNK_TIMEOUT_US) == 0)
+            c->ticket = MEMCOPY_TICKET_NONE;
+        else
+            ret = -1;
+    }
+    return ret;
+}
+
+/* Copy between cached buffers in chunks of about chunk bytes (0 for
+   MEMCOPY_CHUNK_DEFAULT). While the IP copies chunk n the CPU flushes
+   chunk n + 1, which is queued behind it, and invalidates chunk n - 1.
+   Chunks end on dst cache-line boundaries, so invalidating one never
+   writes back a line the IP is filling for the next. Needs two free
+   entries in the channel's job queue. A coherent channel has no cache
+   maintenance to overlap and copies in one job. Returns 0, or -1 on a
+   timeout or a full queue, after every chunk it queued has finished;
+   a chunk that never finishes fails later calls on ch with -1 too. */
+int memcopy_ch_copy_chunked(uint32_t ch, void *dst, const void *src, size_t len, uint32_t chunk)
+{
+    memcopy_chunk_t *c = chunk_rec[ch];
+    UINTPTR d = (UINTPTR)dst, s = (UINTPTR)src;
+    size_t next = 0;                /* offset of the first chunk not queued */
+
+    if (len == 0)
+        return 0;
+    if (memcopy_chunk_drain(ch) != 0)
+        return -1;
+    if (chan[ch].coherent) {
+        memcopy_job_init(&c[0].job, MEMCOPY_OP_COPY, s, d, len);
+        c[0].ticket = memcopy_submit(ch, &c[0].job);
+        if (c[0].ticket == MEMCOPY_TICKET_NONE)
+            return -1;
+        return memcopy_chunk_drain(ch);
+    }
+    if (chunk == 0)
+        chunk = MEMCOPY_CHUNK_DEFAULT;
+    chunk = (chunk + MEMCOPY_CACHE_LINE - 1u) & ~(MEMCOPY_CACHE_LINE - 1u);
+
+    if (memcopy_chunk_queue(ch, &c[0], d, s, &next, len, chunk) != 0)
+        return -1;
+    for (uint32_t i = 0; ; ++i) {
+        memcopy_chunk_t *cur = &c[i % 3u];
+        memcopy_chunk_t *prev = &c[(i + 2u) % 3u];
+        int queued = 0;
+
+        if (next < len)
+            queued = memcopy_chunk_queue(ch, &c[(i + 1u) % 3u], d, s, &next, len, chunk);
+        if (i > 0)
+            memcopy_ch_cache_invalidate(ch, (void *)(d + prev->off), prev->len);
+
+        if (memcopy_wait(cur->ticket, MEMCOPY_CHUNK_TIMEOUT_US) != 0 || queued != 0) {
+            memcopy_chunk_drain(ch);
+            return -1;
+        }
+        cur->ticket = MEMCOPY_TICKET_NONE;
+        if (cur->off + cur->len == len) {
+            memcopy_ch_cache_invalidate(ch, (void *)(d + cur->off), cur->len);
+            return 0;
+        }
+    }
+}
+
+static memcopy_auto_table_t auto_table = { .threshold = MEMCOPY_AUTO_DEFAULT_THRESHOLD };
+
+/* CPU copy: 64 bytes per iteration through the NEON registers when the BSP
+   is built with -mfpu=neon, the C library memcpy otherwise */
+void memcopy_cpu(void *dst, const void *src, size_t len)
+{
+#if defined(__ARM_NEON)
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+
+    for (; len >= 64u; len -= 64u, s += 64, d += 64) {
+        uint8x16_t v0 = vld1q_u8(s), v1 = vld1q_u8(s + 16), v2 = vld1q_u8(s + 32), v3 = vld1q_u8(s + 48);
+        vst1q_u8(d, v0);
+        vst1q_u8(d + 16, v1);
+        vst1q_u8(d + 32, v2);
+        vst1q_u8(d + 48, v3);
+    }
+    memcpy(d, s, len);
+#else
+    memcpy(dst, src, len);
+#endif
+}
+
+/* Accelerator copy on channel 0 with the cache maintenance a CPU caller
+   needs: write back src and dst (no dirty line may be evicted over the
+   result), copy, then drop the stale dst lines; chunked above
+   MEMCOPY_CHUNK_DEFAULT */
+static int memcopy_auto_accel(void *dst, const void *src, size_t len)
+{
+    return memcopy_ch_copy_chunked(0, dst, src, len, 0);
+}
+
+/* memcpy() with the faster engine for len. Returns 0, or -1 if the
+   accelerator timed out. */
+int memcopy_auto(void *dst, const void *src, size_t len)
+{
+    if (len < auto_table.threshold) {
+        memcopy_cpu(dst, src, len);
+        return 0;
+    }
+    return memcopy_auto_accel(dst, src, len);
+}
+
+/* Time each table size on both paths (best of three, src warm in the
+   cache as after a CPU producer) and derive the threshold */
+int memcopy_auto_calibrate(void *scratch_src, void *scratch_dst, uint32_t max_len)
+{
+    XTime t0, t1;
+    uint32_t n = 0;
+
+    memset(scratch_src, 0xA5, max_len);
+    for (uint32_t len = 64u; n < MEMCOPY_AUTO_POINTS && len <= max_len; len <<= 1, ++n) {
+        memcopy_auto_point_t *pt = &auto_table.point[n];
+        pt->len = len;
+        pt->cpu_ticks = UINT32_MAX;
+        pt->accel_ticks = UINT32_MAX;
+        for (int rep = 0; rep < 3; ++rep) {
+            XTime_GetTime(&t0);
+            memcopy_cpu(scratch_dst, scratch_src, len);
+            XTime_GetTime(&t1);
+            if (t1 - t0 < pt->cpu_ticks)
+                pt->cpu_ticks = (uint32_t)(t1 - t0);
+
+            XTime_GetTime(&t0);
+            if (memcopy_auto_accel(scratch_dst, scratch_src, len) != 0)
+                return -1;
+            XTime_GetTime(&t1);
+            if (t1 - t0 < pt->accel_ticks)
+                pt->accel_ticks = (uint32_t)(t1 - t0);
+        }
+    }
+    auto_table.count = n;
+
+    /* Walk down from the largest size while the accelerator still wins */
+    auto_table.threshold = UINT32_MAX;
+    while (n > 0 && auto_table.point[n - 1].accel_ticks < auto_table.point[n - 1].cpu_ticks)
+        auto_table.threshold = auto_table.point[--n].len;
+    return 0;
+}
+
+const memcopy_auto_table_t *memcopy_auto_get_table(void)
 {
-    /* Poll ap_done */
-    while (!memcopy_accel_is_done()) { /* busy wait */ }
-    /* Clear ap_done by reading control register (HLS will clear on handshake or write 0) */
-    /* Often ap_done auto-clears on read; safe to clear ap_start (write 0) */
-    Xil_Out32(base_addr + MEMCOPY_ACCEL_CTRL_OFFSET, 0x0);
+    return &auto_table;
 }
 
-int memcopy_accel_copy_polling(uint32_t src_addr, uint32_t dst_addr, uint32_t len)
+int memcopy_ch_copy_polling(uint32_t ch, uint64_t src_addr, uint64_t dst_addr, uint64_t len)
 {
-    memcopy_accel_start(src_addr, dst_addr, len);
-    memcopy_accel_wait_done();
+    memcopy_ch_start(ch, src_addr, dst_addr, len);
+    memcopy_ch_wait_done(ch);
     return 0;
 }
 
 /* -------------------------------------------------------
  * Enable interrupt (Global + DONE)
  * ------------------------------------------------------- */
-void memcopy_accel_interrupt_enable(void)
+void memcopy_ch_interrupt_enable(uint32_t ch)
 {
-    Xil_Out32(base_addr + MEMCOPY_ACCEL_GIE_OFFSET, MEMCOPY_GIE_ENABLE_MASK);
-    Xil_Out32(base_addr + MEMCOPY_ACCEL_IER_OFFSET, MEMCOPY_IER_CHAN0_INT_EN_MASK);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_GIE_OFFSET, MEMCOPY_GIE_ENABLE_MASK);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_IER_OFFSET, MEMCOPY_IER_CHAN0_INT_EN_MASK);
 }
 
 /* -------------------------------------------------------
  * Clear interrupt after handling
  * ------------------------------------------------------- */
-void memcopy_accel_interrupt_clear(void)
+void memcopy_ch_interrupt_clear(uint32_t ch)
 {
-    Xil_Out32(base_addr + MEMCOPY_ACCEL_ISR_OFFSET, MEMCOPY_ISR_CHAN0_INT_CLEAR_MASK);
+    Xil_Out32(chan[ch].base + MEMCOPY_ACCEL_ISR_OFFSET, MEMCOPY_ISR_CHAN0_INT_CLEAR_MASK);
 }
@@ -62,6 +62,16 @@ u32 XMemcopy_accel_IsReady(XMemcopy_accel *InstancePtr) {
     return !(Data & 0x1);
 }
 
+void XMemcopy_accel_Continue(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_AP_CTRL) & 0x80;
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_AP_CTRL, Data | 0x10);
+}
+
 void XMemcopy_accel_EnableAutoRestart(XMemcopy_accel *InstancePtr) {
     Xil_AssertVoid(InstancePtr != NULL);
     Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
@@ -114,20 +124,430 @@ u64 XMemcopy_accel_Get_dst(XMemcopy_accel *InstancePtr) {
     return Data;
 }
 
-void XMemcopy_accel_Set_len(XMemcopy_accel *InstancePtr, u32 Data) {
+void XMemcopy_accel_Set_len(XMemcopy_accel *InstancePtr, u64 Data) {
     Xil_AssertVoid(InstancePtr != NULL);
     Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
-    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_LEN_DATA, Data);
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_LEN_DATA, (u32)(Data));
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_LEN_DATA + 4, (u32)(Data >> 32));
 }
 
-u32 XMemcopy_accel_Get_len(XMemcopy_accel *InstancePtr) {
-    u32 Data;
+u64 XMemcopy_accel_Get_len(XMemcopy_accel *InstancePtr) {
+    u64 Data;
 
     Xil_AssertNonvoid(InstancePtr != NULL);
     Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
     Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_LEN_DATA);
+    Data += (u64)XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_LEN_DATA + 4) << 32;
+    return Data;
+}
+
+void XMemcopy_accel_Set_src_off(XMemcopy_accel *InstancePtr, u32 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_SRC_OFF_DATA, Data);
+}
+
+u32 XMemcopy_accel_Get_src_off(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_SRC_OFF_DATA);
+    return Data;
+}
+
+void XMemcopy_accel_Set_dst_off(XMemcopy_accel *InstancePtr, u32 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_OFF_DATA, Data);
+}
+
+u32 XMemcopy_accel_Get_dst_off(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_OFF_DATA);
+    return Data;
+}
+
+void XMemcopy_accel_Set_dst_bytes(XMemcopy_accel *InstancePtr, u64 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_BYTES_DATA, (u32)(Data));
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_BYTES_DATA + 4, (u32)(Data >> 32));
+}
+
+u64 XMemcopy_accel_Get_dst_bytes(XMemcopy_accel *InstancePtr) {
+    u64 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_BYTES_DATA);
+    Data += (u64)XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_BYTES_DATA + 4) << 32;
+    return Data;
+}
+
+void XMemcopy_accel_Set_op(XMemcopy_accel *InstancePtr, u32 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_OP_DATA, Data);
+}
+
+u32 XMemcopy_accel_Get_op(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_OP_DATA);
+    return Data;
+}
+
+void XMemcopy_accel_Set_desc(XMemcopy_accel *InstancePtr, u64 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DESC_DATA, (u32)(Data));
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DESC_DATA + 4, (u32)(Data >> 32));
+}
+
+u64 XMemcopy_accel_Get_desc(XMemcopy_accel *InstancePtr) {
+    u64 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DESC_DATA);
+    Data += (u64)XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DESC_DATA + 4) << 32;
+    return Data;
+}
+
+void XMemcopy_accel_Set_rows(XMemcopy_accel *InstancePtr, u32 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_ROWS_DATA, Data);
+}
+
+u32 XMemcopy_accel_Get_rows(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_ROWS_DATA);
+    return Data;
+}
+
+void XMemcopy_accel_Set_row_bytes(XMemcopy_accel *InstancePtr, u32 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_ROW_BYTES_DATA, Data);
+}
+
+u32 XMemcopy_accel_Get_row_bytes(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_ROW_BYTES_DATA);
+    return Data;
+}
+
+void XMemcopy_accel_Set_src_stride(XMemcopy_accel *InstancePtr, u32 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_SRC_STRIDE_DATA, Data);
+}
+
+u32 XMemcopy_accel_Get_src_stride(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_SRC_STRIDE_DATA);
+    return Data;
+}
+
+void XMemcopy_accel_Set_dst_stride(XMemcopy_accel *InstancePtr, u32 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_STRIDE_DATA, Data);
+}
+
+u32 XMemcopy_accel_Get_dst_stride(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_STRIDE_DATA);
+    return Data;
+}
+
+void XMemcopy_accel_Set_fill(XMemcopy_accel *InstancePtr, u32 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_FILL_DATA, Data);
+}
+
+u32 XMemcopy_accel_Get_fill(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_FILL_DATA);
+    return Data;
+}
+
+u32 XMemcopy_accel_Get_crc(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CRC_DATA);
+    return Data;
+}
+
+u32 XMemcopy_accel_Get_crc_vld(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CRC_CTRL);
+    return Data & 0x1;
+}
+
+u32 XMemcopy_accel_Get_cmp_match(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_MATCH_DATA);
+    return Data;
+}
+
+u32 XMemcopy_accel_Get_cmp_match_vld(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_MATCH_CTRL);
+    return Data & 0x1;
+}
+
+u64 XMemcopy_accel_Get_cmp_first(XMemcopy_accel *InstancePtr) {
+    u64 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_FIRST_DATA);
+    Data += (u64)XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_FIRST_DATA + 4) << 32;
+    return Data;
+}
+
+u32 XMemcopy_accel_Get_cmp_first_vld(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_FIRST_CTRL);
+    return Data & 0x1;
+}
+
+u64 XMemcopy_accel_Get_cmp_count(XMemcopy_accel *InstancePtr) {
+    u64 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_COUNT_DATA);
+    Data += (u64)XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_COUNT_DATA + 4) << 32;
+    return Data;
+}
+
+u32 XMemcopy_accel_Get_cmp_count_vld(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_COUNT_CTRL);
+    return Data & 0x1;
+}
+
+u32 XMemcopy_accel_Get_perf_cycles(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_CYCLES_DATA);
+    return Data;
+}
+
+u32 XMemcopy_accel_Get_perf_cycles_vld(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_CYCLES_CTRL);
+    return Data & 0x1;
+}
+
+u32 XMemcopy_accel_Get_perf_rd_beats(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_RD_BEATS_DATA);
+    return Data;
+}
+
+u32 XMemcopy_accel_Get_perf_rd_beats_vld(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_RD_BEATS_CTRL);
+    return Data & 0x1;
+}
+
+u32 XMemcopy_accel_Get_perf_wr_beats(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_WR_BEATS_DATA);
+    return Data;
+}
+
+u32 XMemcopy_accel_Get_perf_wr_beats_vld(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_WR_BEATS_CTRL);
+    return Data & 0x1;
+}
+
+u32 XMemcopy_accel_Get_perf_stall(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_STALL_DATA);
+    return Data;
+}
+
+u32 XMemcopy_accel_Get_perf_stall_vld(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_STALL_CTRL);
+    return Data & 0x1;
+}
+
+void XMemcopy_accel_Set_cpl(XMemcopy_accel *InstancePtr, u64 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CPL_DATA, (u32)(Data));
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CPL_DATA + 4, (u32)(Data >> 32));
+}
+
+u64 XMemcopy_accel_Get_cpl(XMemcopy_accel *InstancePtr) {
+    u64 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CPL_DATA);
+    Data += (u64)XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CPL_DATA + 4) << 32;
+    return Data;
+}
+
+void XMemcopy_accel_Set_ring_prod(XMemcopy_accel *InstancePtr, u64 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_RING_PROD_DATA, (u32)(Data));
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_RING_PROD_DATA + 4, (u32)(Data >> 32));
+}
+
+u64 XMemcopy_accel_Get_ring_prod(XMemcopy_accel *InstancePtr) {
+    u64 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_RING_PROD_DATA);
+    Data += (u64)XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_RING_PROD_DATA + 4) << 32;
+    return Data;
+}
+
+void XMemcopy_accel_Set_irq_count(XMemcopy_accel *InstancePtr, u32 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_IRQ_COUNT_DATA, Data);
+}
+
+u32 XMemcopy_accel_Get_irq_count(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_IRQ_COUNT_DATA);
+    return Data;
+}
+
+void XMemcopy_accel_Set_irq_idle(XMemcopy_accel *InstancePtr, u32 Data) {
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    XMemcopy_accel_WriteReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_IRQ_IDLE_DATA, Data);
+}
+
+u32 XMemcopy_accel_Get_irq_idle(XMemcopy_accel *InstancePtr) {
+    u32 Data;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    Data = XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_IRQ_IDLE_DATA);
     return Data;
 }
 
@@ -22,11 +22,16 @@ extern "C" {
 #include <stdint.h>
 #include <assert.h>
 #include <dirent.h>
+#include <errno.h>
 #include <fcntl.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <sched.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mman.h>
+#include <time.h>
 #include <unistd.h>
 #include <stddef.h>
 #endif
@@ -38,6 +43,29 @@ typedef uint8_t u8;
 typedef uint16_t u16;
 typedef uint32_t u32;
 typedef uint64_t u64;
+
+// One DMA buffer of a pool: the CPU mapping and the bus address to program
+typedef struct {
+    void *Virt;
+    u64 Phys;
+    u32 Size;
+} XMemcopy_accel_Buf;
+
+// Physically contiguous region cut into equal slabs. Backed by a UIO map
+// (reserved memory, mapped uncached by the UIO core) or a u-dma-buf
+// device (cached unless opened with O_SYNC, synced through its sysfs).
+typedef struct {
+    u8 *Virt;
+    u64 Phys;
+    u64 Size;           // bytes mapped
+    u32 SlabSize;
+    u32 SlabCount;
+    u32 FreeHead;       // first free slab, SlabCount when none
+    u32 FreeCount;
+    u32 *Next;          // free list links, kept outside the DMA memory
+    int Fd;             // -1 for a UIO map (the instance owns the fd)
+    int SyncFd[4];      // u-dma-buf sync_offset/size/for_cpu/for_device, -1 if unused
+} XMemcopy_accel_Pool;
 #else
 typedef struct {
 #ifdef SDT
@@ -52,6 +80,10 @@ typedef struct {
 typedef struct {
     u64 Ctrl_bus_BaseAddress;
     u32 IsReady;
+#ifdef __linux__
+    u32 Claimed;                            // owner flag, see XMemcopy_accel_TryClaim()
+    struct XMemcopy_accel_uio_info *Uio;    // this instance's /dev/uioN fd and maps
+#endif
 } XMemcopy_accel;
 
 typedef u32 word_type;
@@ -73,8 +105,17 @@ typedef u32 word_type;
 
 #define XST_SUCCESS             0
 #define XST_DEVICE_NOT_FOUND    2
+#define XST_FAILURE             1
 #define XST_OPEN_DEVICE_FAILED  3
+#define XST_TIMEOUT             4
 #define XIL_COMPONENT_IS_READY  1
+
+// Data bus width of AXI_SRC/AXI_DST in bytes (BUS_WIDTH / 8 of the IP) and
+// the op code of a plain copy, for XMemcopy_accel_StartCopy()
+#ifndef XMEMCOPY_ACCEL_BUS_BYTES
+#define XMEMCOPY_ACCEL_BUS_BYTES 8
+#endif
+#define XMEMCOPY_ACCEL_OP_COPY   0
 #endif
 
 /************************** Function Prototypes *****************************/
@@ -88,14 +129,34 @@ XMemcopy_accel_Config* XMemcopy_accel_LookupConfig(u16 DeviceId);
 #endif
 int XMemcopy_accel_CfgInitialize(XMemcopy_accel *InstancePtr, XMemcopy_accel_Config *ConfigPtr);
 #else
+int XMemcopy_accel_SetUioPaths(const char* SysfsRoot, const char* DevDir);
 int XMemcopy_accel_Initialize(XMemcopy_accel *InstancePtr, const char* InstanceName);
+int XMemcopy_accel_InitializeAll(XMemcopy_accel *InstancePtrs, int MaxInstances, const char* InstanceName);
 int XMemcopy_accel_Release(XMemcopy_accel *InstancePtr);
+int XMemcopy_accel_GetIrqFd(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_AckIrq(XMemcopy_accel *InstancePtr);
+int XMemcopy_accel_WaitIrq(XMemcopy_accel *InstancePtr, int TimeoutMs);
+
+int XMemcopy_accel_TryClaim(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Unclaim(XMemcopy_accel *InstancePtr);
+int XMemcopy_accel_ClaimAny(XMemcopy_accel *InstancePtrs, int Count);
+void XMemcopy_accel_StartCopy(XMemcopy_accel *InstancePtr, u64 Src, u64 Dst, u64 Len);
+int XMemcopy_accel_Complete(XMemcopy_accel *InstancePtr, int TimeoutMs);
+
+int XMemcopy_accel_PoolOpenUio(XMemcopy_accel_Pool *PoolPtr, XMemcopy_accel *InstancePtr, int MapIndex, u32 SlabSize);
+int XMemcopy_accel_PoolOpenUdmabuf(XMemcopy_accel_Pool *PoolPtr, const char* DeviceName, u32 SlabSize);
+void XMemcopy_accel_PoolClose(XMemcopy_accel_Pool *PoolPtr);
+int XMemcopy_accel_PoolAlloc(XMemcopy_accel_Pool *PoolPtr, XMemcopy_accel_Buf *BufPtr);
+void XMemcopy_accel_PoolFree(XMemcopy_accel_Pool *PoolPtr, XMemcopy_accel_Buf *BufPtr);
+int XMemcopy_accel_PoolSyncForDevice(XMemcopy_accel_Pool *PoolPtr, XMemcopy_accel_Buf *BufPtr, u32 Offset, u32 Length);
+int XMemcopy_accel_PoolSyncForCpu(XMemcopy_accel_Pool *PoolPtr, XMemcopy_accel_Buf *BufPtr, u32 Offset, u32 Length);
 #endif
 
 void XMemcopy_accel_Start(XMemcopy_accel *InstancePtr);
 u32 XMemcopy_accel_IsDone(XMemcopy_accel *InstancePtr);
 u32 XMemcopy_accel_IsIdle(XMemcopy_accel *InstancePtr);
 u32 XMemcopy_accel_IsReady(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Continue(XMemcopy_accel *InstancePtr);
 void XMemcopy_accel_EnableAutoRestart(XMemcopy_accel *InstancePtr);
 void XMemcopy_accel_DisableAutoRestart(XMemcopy_accel *InstancePtr);
 
@@ -103,8 +164,52 @@ void XMemcopy_accel_Set_src(XMemcopy_accel *InstancePtr, u64 Data);
 u64 XMemcopy_accel_Get_src(XMemcopy_accel *InstancePtr);
 void XMemcopy_accel_Set_dst(XMemcopy_accel *InstancePtr, u64 Data);
 u64 XMemcopy_accel_Get_dst(XMemcopy_accel *InstancePtr);
-void XMemcopy_accel_Set_len(XMemcopy_accel *InstancePtr, u32 Data);
-u32 XMemcopy_accel_Get_len(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_len(XMemcopy_accel *InstancePtr, u64 Data);
+u64 XMemcopy_accel_Get_len(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_src_off(XMemcopy_accel *InstancePtr, u32 Data);
+u32 XMemcopy_accel_Get_src_off(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_dst_off(XMemcopy_accel *InstancePtr, u32 Data);
+u32 XMemcopy_accel_Get_dst_off(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_dst_bytes(XMemcopy_accel *InstancePtr, u64 Data);
+u64 XMemcopy_accel_Get_dst_bytes(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_op(XMemcopy_accel *InstancePtr, u32 Data);
+u32 XMemcopy_accel_Get_op(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_desc(XMemcopy_accel *InstancePtr, u64 Data);
+u64 XMemcopy_accel_Get_desc(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_rows(XMemcopy_accel *InstancePtr, u32 Data);
+u32 XMemcopy_accel_Get_rows(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_row_bytes(XMemcopy_accel *InstancePtr, u32 Data);
+u32 XMemcopy_accel_Get_row_bytes(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_src_stride(XMemcopy_accel *InstancePtr, u32 Data);
+u32 XMemcopy_accel_Get_src_stride(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_dst_stride(XMemcopy_accel *InstancePtr, u32 Data);
+u32 XMemcopy_accel_Get_dst_stride(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_fill(XMemcopy_accel *InstancePtr, u32 Data);
+u32 XMemcopy_accel_Get_fill(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_crc(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_crc_vld(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_cmp_match(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_cmp_match_vld(XMemcopy_accel *InstancePtr);
+u64 XMemcopy_accel_Get_cmp_first(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_cmp_first_vld(XMemcopy_accel *InstancePtr);
+u64 XMemcopy_accel_Get_cmp_count(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_cmp_count_vld(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_perf_cycles(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_perf_cycles_vld(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_perf_rd_beats(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_perf_rd_beats_vld(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_perf_wr_beats(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_perf_wr_beats_vld(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_perf_stall(XMemcopy_accel *InstancePtr);
+u32 XMemcopy_accel_Get_perf_stall_vld(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_cpl(XMemcopy_accel *InstancePtr, u64 Data);
+u64 XMemcopy_accel_Get_cpl(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_ring_prod(XMemcopy_accel *InstancePtr, u64 Data);
+u64 XMemcopy_accel_Get_ring_prod(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_irq_count(XMemcopy_accel *InstancePtr, u32 Data);
+u32 XMemcopy_accel_Get_irq_count(XMemcopy_accel *InstancePtr);
+void XMemcopy_accel_Set_irq_idle(XMemcopy_accel *InstancePtr, u32 Data);
+u32 XMemcopy_accel_Get_irq_idle(XMemcopy_accel *InstancePtr);
 
 void XMemcopy_accel_InterruptGlobalEnable(XMemcopy_accel *InstancePtr);
 void XMemcopy_accel_InterruptGlobalDisable(XMemcopy_accel *InstancePtr);
@@ -0,0 +1,272 @@
+// ==============================================================
+// C++20 front-end for the Linux (UIO) memcopy_accel driver
+//
+// xmemcopy::device opens every engine with a given UIO name, owns them
+// (RAII: released in the destructor) and turns their completion
+// interrupts into coroutine resumptions:
+//
+//   xmemcopy::device dev("memcopy_accel");
+//   co_await dev.copy(src.Phys, dst.Phys, len);          // one copy
+//   co_await dev.copy(std::span<const copy_desc>(v));    // batch
+//
+// Awaiting never polls. Completions are dispatched by run_once() from the
+// thread that owns the event loop: it sleeps in epoll_wait() on the UIO
+// fds, or native_handle() can be added to an existing epoll/asio loop and
+// run_once(0) called when it is readable. Coroutines resume on that
+// thread. copy() may be awaited from any thread.
+// ==============================================================
+#ifndef XMEMCOPY_ACCEL_HPP
+#define XMEMCOPY_ACCEL_HPP
+
+#ifdef __linux__
+
+#include <atomic>
+#include <cerrno>
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include "xmemcopy_accel.h"
+
+namespace xmemcopy {
+
+// One copy of a batch (bus addresses, any byte alignment)
+struct copy_desc {
+    u64 src;
+    u64 dst;
+    u64 len;
+};
+
+class device;
+
+namespace detail {
+
+// Completion counter shared by the ops of one batch
+struct batch_state {
+    std::atomic<std::size_t> remaining{0};
+    std::coroutine_handle<> waiter;
+};
+
+// One queued or running copy. Lives in the awaiting coroutine's frame.
+struct op {
+    copy_desc desc{};
+    op* next = nullptr;
+    std::coroutine_handle<> waiter;     // single copy
+    batch_state* batch = nullptr;       // or the batch it belongs to
+
+    void complete() {
+        if (!batch) {
+            waiter.resume();
+        } else if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            batch->waiter.resume();
+        }
+    }
+};
+
+} // namespace detail
+
+class device {
+public:
+    // Open up to max_engines UIO devices named name and enable their
+    // ap_done interrupt. Throws std::system_error if none can be opened.
+    explicit device(const char* name = "memcopy_accel", int max_engines = 8)
+        : engines_(max_engines > 0 ? max_engines : 1), active_(engines_.size(), nullptr) {
+        int n = XMemcopy_accel_InitializeAll(engines_.data(), (int)engines_.size(), name);
+        if (n <= 0)
+            throw std::system_error(ENODEV, std::generic_category(), std::string("xmemcopy: no UIO device ") + name);
+        engines_.resize(n);
+        active_.resize(n);
+
+        epfd_ = epoll_create1(EPOLL_CLOEXEC);
+        if (epfd_ < 0) {
+            int err = errno;
+            release();
+            throw std::system_error(err, std::generic_category(), "xmemcopy: epoll_create1");
+        }
+        for (int i = 0; i < n; ++i) {
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.u32 = (u32)i;
+            if (epoll_ctl(epfd_, EPOLL_CTL_ADD, XMemcopy_accel_GetIrqFd(&engines_[i]), &ev) < 0) {
+                int err = errno;
+                release();
+                throw std::system_error(err, std::generic_category(), "xmemcopy: epoll_ctl");
+            }
+            // a previous user may have left ap_done held or ISR bits set;
+            // drop them so the first interrupt belongs to one of our copies
+            if (XMemcopy_accel_IsDone(&engines_[i])) XMemcopy_accel_Continue(&engines_[i]);
+            XMemcopy_accel_InterruptClear(&engines_[i], XMemcopy_accel_InterruptGetStatus(&engines_[i]));
+            XMemcopy_accel_InterruptEnable(&engines_[i], 0x1);     // ap_done
+            XMemcopy_accel_InterruptGlobalEnable(&engines_[i]);
+        }
+    }
+
+    // No copy may be in flight
+    ~device() { release(); }
+
+    device(const device&) = delete;
+    device& operator=(const device&) = delete;
+
+    int engines() const { return (int)engines_.size(); }
+
+    // epoll fd, readable when run_once() has completions to dispatch
+    int native_handle() const { return epfd_; }
+
+    // Wait up to timeout_ms (-1 = forever) for completion interrupts, start
+    // queued copies on the engines that finished and resume the waiters.
+    // Returns the number of copies completed.
+    std::size_t run_once(int timeout_ms = -1) {
+        epoll_event ev[16];
+        detail::op* done[16];
+        std::size_t count = 0;
+        int n;
+
+        do {
+            n = epoll_wait(epfd_, ev, 16, timeout_ms);
+        } while (n < 0 && errno == EINTR);
+        for (int k = 0; k < n; ++k) {
+            u32 i = ev[k].data.u32;
+            XMemcopy_accel* e = &engines_[i];
+
+            XMemcopy_accel_AckIrq(e);
+            if (!XMemcopy_accel_IsDone(e)) continue;
+            XMemcopy_accel_Continue(e);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!active_[i]) continue;      // a run we did not start
+            done[count++] = active_[i];
+            active_[i] = pop();
+            if (active_[i]) {
+                // keep the engine claimed and busy
+                start(e, active_[i]);
+            } else {
+                XMemcopy_accel_Unclaim(e);
+            }
+        }
+        // resume outside the lock: a waiter may submit again
+        for (std::size_t k = 0; k < count; ++k) done[k]->complete();
+        return count;
+    }
+
+    // Dispatch completions until stop() is called
+    void run() {
+        while (!stopped_.load(std::memory_order_acquire)) run_once(100);
+    }
+    void stop() { stopped_.store(true, std::memory_order_release); }
+
+    class copy_awaiter {
+    public:
+        copy_awaiter(device& dev, copy_desc desc) : dev_(dev) { op_.desc = desc; }
+        bool await_ready() const noexcept { return op_.desc.len == 0; }
+        void await_suspend(std::coroutine_handle<> h) {
+            op_.waiter = h;
+            dev_.submit(&op_);      // may resume h on the reactor thread
+        }
+        void await_resume() const noexcept {}
+    private:
+        device& dev_;
+        detail::op op_;
+    };
+
+    class batch_awaiter {
+    public:
+        batch_awaiter(device& dev, std::span<const copy_desc> descs) : dev_(dev), ops_(descs.size()) {
+            for (std::size_t i = 0; i < descs.size(); ++i) {
+                ops_[i].desc = descs[i];
+                ops_[i].batch = &state_;
+            }
+        }
+        bool await_ready() const noexcept { return ops_.empty(); }
+        void await_suspend(std::coroutine_handle<> h) {
+            device& dev = dev_;
+            detail::op* p = ops_.data();
+            detail::op* end = p + ops_.size();
+
+            state_.waiter = h;
+            state_.remaining.store(ops_.size(), std::memory_order_release);
+            // *this may be gone once the last op is submitted: locals only
+            dev.submit_all(p, end);
+        }
+        void await_resume() const noexcept {}
+    private:
+        device& dev_;
+        std::vector<detail::op> ops_;
+        detail::batch_state state_;
+    };
+
+    // co_await: resumes once the copy is complete
+    copy_awaiter copy(u64 src, u64 dst, u64 len) { return copy_awaiter(*this, copy_desc{src, dst, len}); }
+
+    // co_await: copies spread over all engines, resumes once after the last
+    batch_awaiter copy(std::span<const copy_desc> descs) { return batch_awaiter(*this, descs); }
+
+private:
+    void start(XMemcopy_accel* e, detail::op* o) {
+        XMemcopy_accel_StartCopy(e, o->desc.src, o->desc.dst, o->desc.len);
+    }
+
+    detail::op* pop() {
+        detail::op* o = head_;
+        if (o) {
+            head_ = o->next;
+            if (!head_) tail_ = nullptr;
+        }
+        return o;
+    }
+
+    // Start on a free engine or queue behind the running ones. Claiming
+    // happens under mutex_ so a copy cannot be queued just after the
+    // reactor found the queue empty and let its engine go.
+    void submit(detail::op* o) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        submit_locked(o);
+    }
+
+    void submit_all(detail::op* p, detail::op* end) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (; p != end; ++p) submit_locked(p);
+    }
+
+    void submit_locked(detail::op* o) {
+        int i = XMemcopy_accel_ClaimAny(engines_.data(), (int)engines_.size());
+        if (i >= 0) {
+            active_[i] = o;
+            start(&engines_[i], o);
+            return;
+        }
+        o->next = nullptr;
+        if (tail_) tail_->next = o; else head_ = o;
+        tail_ = o;
+    }
+
+    void release() {
+        for (auto& e : engines_) {
+            if (e.IsReady != XIL_COMPONENT_IS_READY) continue;
+            XMemcopy_accel_InterruptGlobalDisable(&e);
+            XMemcopy_accel_Release(&e);
+        }
+        engines_.clear();
+        if (epfd_ >= 0) close(epfd_);
+        epfd_ = -1;
+    }
+
+    std::vector<XMemcopy_accel> engines_;
+    std::vector<detail::op*> active_;   // running copy per engine
+    detail::op* head_ = nullptr;        // copies waiting for an engine
+    detail::op* tail_ = nullptr;
+    std::mutex mutex_;
+    std::atomic<bool> stopped_{false};
+    int epfd_ = -1;
+};
+
+} // namespace xmemcopy
+
+#endif // __linux__
+
+#endif // XMEMCOPY_ACCEL_HPP
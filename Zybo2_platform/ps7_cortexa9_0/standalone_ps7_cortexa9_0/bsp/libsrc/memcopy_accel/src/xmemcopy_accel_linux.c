@@ -12,9 +12,16 @@
 
 /***************** Macros (Inline Functions) Definitions *********************/
 #define MAX_UIO_PATH_SIZE       256
+#define MAX_UIO_ROOT_SIZE       192     // room for "/uioN/maps/mapN/addr" after it
 #define MAX_UIO_NAME_SIZE       64
 #define MAX_UIO_MAPS            5
+#define MAX_UIO_INSTANCES       64
 #define UIO_INVALID_ADDR        0
+#define POOL_SLAB_ALIGN         64      // cache line of the A9 and the A53
+#define POOL_SYNC_OFFSET        0
+#define POOL_SYNC_SIZE          1
+#define POOL_SYNC_FOR_CPU       2
+#define POOL_SYNC_FOR_DEVICE    3
 
 /**************************** Type Definitions ******************************/
 typedef struct {
@@ -22,7 +29,7 @@ typedef struct {
     u32 size;
 } XMemcopy_accel_uio_map;
 
-typedef struct {
+typedef struct XMemcopy_accel_uio_info {
     int  uio_fd;
     int  uio_num;
     char name[ MAX_UIO_NAME_SIZE ];
@@ -31,7 +38,11 @@ typedef struct {
 } XMemcopy_accel_uio_info;
 
 /***************** Variable Definitions **************************************/
-static XMemcopy_accel_uio_info uio_info;
+static u32 claim_hint;  // where XMemcopy_accel_ClaimAny() starts looking next
+static char uio_sysfs[ MAX_UIO_ROOT_SIZE ] = "/sys/class/uio";
+static char uio_dev[ MAX_UIO_ROOT_SIZE ] = "/dev";
+static const char* const udmabuf_class[] = { "/sys/class/u-dma-buf", "/sys/class/udmabuf" };
+static const char* const udmabuf_sync[] = { "sync_offset", "sync_size", "sync_for_cpu", "sync_for_device" };
 
 /************************** Function Implementation *************************/
 static int line_from_file(char* filename, char* linebuf) {
@@ -51,13 +62,13 @@ static int line_from_file(char* filename, char* linebuf) {
 
 static int uio_info_read_name(XMemcopy_accel_uio_info* info) {
     char file[ MAX_UIO_PATH_SIZE ];
-    sprintf(file, "/sys/class/uio/uio%d/name", info->uio_num);
+    sprintf(file, "%s/uio%d/name", uio_sysfs, info->uio_num);
     return line_from_file(file, info->name);
 }
 
 static int uio_info_read_version(XMemcopy_accel_uio_info* info) {
     char file[ MAX_UIO_PATH_SIZE ];
-    sprintf(file, "/sys/class/uio/uio%d/version", info->uio_num);
+    sprintf(file, "%s/uio%d/version", uio_sysfs, info->uio_num);
     return line_from_file(file, info->version);
 }
 
@@ -65,10 +76,10 @@ static int uio_info_read_map_addr(XMemcopy_accel_uio_info* info, int n) {
     int ret;
     char file[ MAX_UIO_PATH_SIZE ];
     info->maps[n].addr = UIO_INVALID_ADDR;
-    sprintf(file, "/sys/class/uio/uio%d/maps/map%d/addr", info->uio_num, n);
+    sprintf(file, "%s/uio%d/maps/map%d/addr", uio_sysfs, info->uio_num, n);
     FILE* fp = fopen(file, "r");
     if (!fp) return -1;
-    ret = fscanf(fp, "0x%x", &info->maps[n].addr);
+    ret = fscanf(fp, "0x%" SCNx64, &info->maps[n].addr);
     fclose(fp);
     if (ret < 0) return -2;
     return 0;
@@ -77,7 +88,7 @@ static int uio_info_read_map_addr(XMemcopy_accel_uio_info* info, int n) {
 static int uio_info_read_map_size(XMemcopy_accel_uio_info* info, int n) {
     int ret;
     char file[ MAX_UIO_PATH_SIZE ];
-    sprintf(file, "/sys/class/uio/uio%d/maps/map%d/size", info->uio_num, n);
+    sprintf(file, "%s/uio%d/maps/map%d/size", uio_sysfs, info->uio_num, n);
     FILE* fp = fopen(file, "r");
     if (!fp) return -1;
     ret = fscanf(fp, "0x%x", &info->maps[n].size);
@@ -86,33 +97,56 @@ static int uio_info_read_map_size(XMemcopy_accel_uio_info* info, int n) {
     return 0;
 }
 
-int XMemcopy_accel_Initialize(XMemcopy_accel *InstancePtr, const char* InstanceName) {
-	XMemcopy_accel_uio_info *InfoPtr = &uio_info;
-	struct dirent **namelist;
-    int i, n;
-    char* s;
+static int uio_irq_unmask(XMemcopy_accel_uio_info* info) {
+    u32 enable = 1;
+    // Fails harmlessly on UIO drivers without irqcontrol
+    if (write(info->uio_fd, &enable, sizeof(enable)) != sizeof(enable)) return -1;
+    return 0;
+}
+
+// Numbers N of the <sysfs root>/uioN devices named InstanceName, in
+// ascending order. Every match is considered and the lowest Max are
+// kept. Returns how many were stored (at most Max).
+static int uio_find(const char* InstanceName, int* Nums, int Max) {
+    struct dirent **namelist;
+    int i, j, n, num;
+    int found = 0;
     char file[ MAX_UIO_PATH_SIZE ];
     char name[ MAX_UIO_NAME_SIZE ];
-    int flag = 0;
 
-    assert(InstancePtr != NULL);
-
-    n = scandir("/sys/class/uio", &namelist, 0, alphasort);
-    if (n < 0)  return XST_DEVICE_NOT_FOUND;
+    n = scandir(uio_sysfs, &namelist, 0, alphasort);
+    if (n < 0)  return 0;
     for (i = 0;  i < n; i++) {
-    	strcpy(file, "/sys/class/uio/");
-    	strcat(file, namelist[i]->d_name);
-    	strcat(file, "/name");
-        if ((line_from_file(file, name) == 0) && (strcmp(name, InstanceName) == 0)) {
-            flag = 1;
-            s = namelist[i]->d_name;
-            s += 3; // "uio"
-            InfoPtr->uio_num = atoi(s);
-            break;
+        strcpy(file, uio_sysfs);
+        strcat(file, "/");
+        strcat(file, namelist[i]->d_name);
+        strcat(file, "/name");
+        if (Max > 0 && (line_from_file(file, name) == 0) && (strcmp(name, InstanceName) == 0)) {
+            num = atoi(namelist[i]->d_name + 3); // "uio"
+            // alphasort puts uio10 before uio2: insertion sort, and once
+            // Nums is full a lower number pushes out the highest
+            if (found == Max && Nums[Max - 1] > num) found--;
+            if (found < Max) {
+                for (j = found; j > 0 && Nums[j - 1] > num; --j) Nums[j] = Nums[j - 1];
+                Nums[j] = num;
+                found++;
+            }
         }
+        free(namelist[i]);
     }
-    if (flag == 0)  return XST_DEVICE_NOT_FOUND;
+    free(namelist);
+    return found;
+}
 
+static int uio_open(XMemcopy_accel *InstancePtr, int UioNum) {
+    XMemcopy_accel_uio_info *InfoPtr;
+    char file[ MAX_UIO_PATH_SIZE ];
+    void *regs;
+    int n;
+
+    InfoPtr = calloc(1, sizeof(*InfoPtr));
+    if (!InfoPtr) return XST_FAILURE;
+    InfoPtr->uio_num = UioNum;
     uio_info_read_name(InfoPtr);
     uio_info_read_version(InfoPtr);
     for (n = 0; n < MAX_UIO_MAPS; ++n) {
@@ -120,31 +154,456 @@ int XMemcopy_accel_Initialize(XMemcopy_accel *InstancePtr, const char* InstanceN
         uio_info_read_map_size(InfoPtr, n);
     }
 
-    sprintf(file, "/dev/uio%d", InfoPtr->uio_num);
+    sprintf(file, "%s/uio%d", uio_dev, InfoPtr->uio_num);
     if ((InfoPtr->uio_fd = open(file, O_RDWR)) < 0) {
+        free(InfoPtr);
         return XST_OPEN_DEVICE_FAILED;
     }
+    // Unmask the interrupt line in case a previous user left it masked
+    // (uio_pdrv_genirq masks it in its handler until user space writes 1)
+    uio_irq_unmask(InfoPtr);
 
     // NOTE: slave interface 'Ctrl_bus' should be mapped to uioX/map0
-    InstancePtr->Ctrl_bus_BaseAddress = (u64)mmap(NULL, InfoPtr->maps[0].size, PROT_READ|PROT_WRITE, MAP_SHARED, InfoPtr->uio_fd, 0 * getpagesize());
-    assert(InstancePtr->Ctrl_bus_BaseAddress);
+    regs = mmap(NULL, InfoPtr->maps[0].size, PROT_READ|PROT_WRITE, MAP_SHARED, InfoPtr->uio_fd, 0 * getpagesize());
+    if (regs == MAP_FAILED) {
+        close(InfoPtr->uio_fd);
+        free(InfoPtr);
+        return XST_OPEN_DEVICE_FAILED;
+    }
 
+    InstancePtr->Ctrl_bus_BaseAddress = (u64)regs;
+    InstancePtr->Uio = InfoPtr;
+    InstancePtr->Claimed = 0;
     InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
 
     return XST_SUCCESS;
 }
 
+// Where XMemcopy_accel_Initialize()/InitializeAll() look for devices:
+// SysfsRoot replaces /sys/class/uio and DevDir replaces /dev (NULL keeps
+// the current one). For test trees, e.g. src/Host-Sim/fake_uio.c; call
+// before initializing. Returns XST_FAILURE if a path is too long.
+int XMemcopy_accel_SetUioPaths(const char* SysfsRoot, const char* DevDir) {
+    if ((SysfsRoot && strlen(SysfsRoot) >= MAX_UIO_ROOT_SIZE) ||
+        (DevDir && strlen(DevDir) >= MAX_UIO_ROOT_SIZE))
+        return XST_FAILURE;
+    if (SysfsRoot) strcpy(uio_sysfs, SysfsRoot);
+    if (DevDir) strcpy(uio_dev, DevDir);
+    return XST_SUCCESS;
+}
+
+// Open the first UIO device named InstanceName. Each instance keeps its
+// own fd and maps, so several instances can be open at once.
+int XMemcopy_accel_Initialize(XMemcopy_accel *InstancePtr, const char* InstanceName) {
+    int num;
+
+    assert(InstancePtr != NULL);
+
+    if (uio_find(InstanceName, &num, 1) == 0)  return XST_DEVICE_NOT_FOUND;
+    return uio_open(InstancePtr, num);
+}
+
+// Open every UIO device named InstanceName (one per accelerator in the
+// device tree, uio_pdrv_genirq names them after the node) into
+// InstancePtrs[0..MaxInstances-1], lowest uioN first. Devices that fail
+// to open are skipped. Returns the number of instances initialized.
+int XMemcopy_accel_InitializeAll(XMemcopy_accel *InstancePtrs, int MaxInstances, const char* InstanceName) {
+    int nums[ MAX_UIO_INSTANCES ];
+    int i, n;
+    int count = 0;
+
+    assert(InstancePtrs != NULL);
+
+    if (MaxInstances > MAX_UIO_INSTANCES) MaxInstances = MAX_UIO_INSTANCES;
+    n = uio_find(InstanceName, nums, MaxInstances);
+    for (i = 0; i < n; ++i) {
+        if (uio_open(&InstancePtrs[count], nums[i]) == XST_SUCCESS) count++;
+    }
+    return count;
+}
+
 int XMemcopy_accel_Release(XMemcopy_accel *InstancePtr) {
-	XMemcopy_accel_uio_info *InfoPtr = &uio_info;
+    XMemcopy_accel_uio_info *InfoPtr;
 
     assert(InstancePtr != NULL);
     assert(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+    InfoPtr = InstancePtr->Uio;
     munmap((void*)InstancePtr->Ctrl_bus_BaseAddress, InfoPtr->maps[0].size);
 
     close(InfoPtr->uio_fd);
+    free(InfoPtr);
+    InstancePtr->Uio = NULL;
+    InstancePtr->IsReady = 0;
+
+    return XST_SUCCESS;
+}
+
+// File descriptor of /dev/uioN: readable (POLLIN / EPOLLIN) once the IP
+// has raised its interrupt. Add it to the caller's poll/epoll set and call
+// XMemcopy_accel_AckIrq() when it becomes readable.
+int XMemcopy_accel_GetIrqFd(XMemcopy_accel *InstancePtr) {
+    assert(InstancePtr != NULL);
+    assert(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    return InstancePtr->Uio->uio_fd;
+}
 
+// Consume the pending UIO event, clear the IP interrupt status and unmask
+// the line again, in that order so a level still high is not taken twice.
+// XST_FAILURE if the event cannot be read; the ISR bits go to *Status.
+static int uio_ack(XMemcopy_accel *InstancePtr, u32* Status) {
+    XMemcopy_accel_uio_info *InfoPtr = InstancePtr->Uio;
+    u32 count;
+
+    *Status = 0;
+    if (read(InfoPtr->uio_fd, &count, sizeof(count)) != sizeof(count)) return XST_FAILURE;
+    *Status = XMemcopy_accel_InterruptGetStatus(InstancePtr);
+    XMemcopy_accel_InterruptClear(InstancePtr, *Status);
+    uio_irq_unmask(InfoPtr);
     return XST_SUCCESS;
 }
 
+// Acknowledge the pending interrupt as above. Returns the ISR bits that
+// were set (ap_done = bit 0, ap_ready = bit 1); a failed read also
+// returns 0, XMemcopy_accel_WaitIrq() reports it as XST_FAILURE. Blocks
+// if no event is pending. With ap_ctrl_chain, ap_done is still held until
+// XMemcopy_accel_Continue().
+u32 XMemcopy_accel_AckIrq(XMemcopy_accel *InstancePtr) {
+    u32 status;
+
+    assert(InstancePtr != NULL);
+    assert(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    uio_ack(InstancePtr, &status);
+    return status;
+}
+
+// Sleep until the IP interrupts (enable it first with
+// XMemcopy_accel_InterruptGlobalEnable/InterruptEnable), then acknowledge
+// it. TimeoutMs < 0 waits forever. Returns XST_SUCCESS, XST_TIMEOUT or
+// XST_FAILURE (also when the event cannot be read from the fd).
+int XMemcopy_accel_WaitIrq(XMemcopy_accel *InstancePtr, int TimeoutMs) {
+    struct pollfd pfd;
+    u32 status;
+    int ret;
+
+    assert(InstancePtr != NULL);
+    assert(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    pfd.fd = InstancePtr->Uio->uio_fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    do {
+        ret = poll(&pfd, 1, TimeoutMs);
+    } while (ret < 0 && errno == EINTR);
+    if (ret == 0) return XST_TIMEOUT;
+    if (ret < 0 || !(pfd.revents & POLLIN)) return XST_FAILURE;
+
+    return uio_ack(InstancePtr, &status);
+}
+
+/* Engine ownership. One thread at a time programs an engine: it claims
+   it with an atomic exchange, starts one job, waits for it and lets go in
+   XMemcopy_accel_Complete(). No lock is taken and no syscall is made on
+   the submission side, so threads sharding copies over several engines
+   only contend on the engine they both try to claim. */
+int XMemcopy_accel_TryClaim(XMemcopy_accel *InstancePtr) {
+    assert(InstancePtr != NULL);
+    assert(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    if (__atomic_exchange_n(&InstancePtr->Claimed, 1, __ATOMIC_ACQUIRE) != 0)
+        return XST_FAILURE;
+    return XST_SUCCESS;
+}
+
+void XMemcopy_accel_Unclaim(XMemcopy_accel *InstancePtr) {
+    assert(InstancePtr != NULL);
+
+    __atomic_store_n(&InstancePtr->Claimed, 0, __ATOMIC_RELEASE);
+}
+
+// Claim any free engine of InstancePtrs[0..Count-1]. The scan starts one
+// past the previous winner so concurrent callers spread over the engines.
+// Returns the index of the claimed engine, or -1 if all are busy.
+int XMemcopy_accel_ClaimAny(XMemcopy_accel *InstancePtrs, int Count) {
+    u32 start;
+    int i, idx;
+
+    assert(InstancePtrs != NULL);
+
+    if (Count <= 0) return -1;
+    start = __atomic_fetch_add(&claim_hint, 1, __ATOMIC_RELAXED);
+    for (i = 0; i < Count; ++i) {
+        idx = (int)((start + (u32)i) % (u32)Count);
+        if (XMemcopy_accel_TryClaim(&InstancePtrs[idx]) == XST_SUCCESS) return idx;
+    }
+    return -1;
+}
+
+// Program and start one copy on a claimed engine. Src and Dst are bus
+// addresses at any byte alignment (the IP takes bus-aligned bases plus
+// the offset of the first byte, see memcopy_ch_start_transform()).
+void XMemcopy_accel_StartCopy(XMemcopy_accel *InstancePtr, u64 Src, u64 Dst, u64 Len) {
+    u64 src_base = Src & ~(u64)(XMEMCOPY_ACCEL_BUS_BYTES - 1);
+    u64 dst_base = Dst & ~(u64)(XMEMCOPY_ACCEL_BUS_BYTES - 1);
+
+    assert(InstancePtr != NULL);
+    assert(InstancePtr->Claimed);
+
+    XMemcopy_accel_Set_src(InstancePtr, src_base);
+    XMemcopy_accel_Set_dst(InstancePtr, dst_base);
+    XMemcopy_accel_Set_len(InstancePtr, Len);
+    XMemcopy_accel_Set_src_off(InstancePtr, (u32)(Src - src_base));
+    XMemcopy_accel_Set_dst_off(InstancePtr, (u32)(Dst - dst_base));
+    XMemcopy_accel_Set_dst_bytes(InstancePtr, dst_base);
+    XMemcopy_accel_Set_op(InstancePtr, XMEMCOPY_ACCEL_OP_COPY);
+    XMemcopy_accel_Start(InstancePtr);
+}
+
+// Milliseconds from now to End, rounded up; 0 once End has passed
+static int ms_left(const struct timespec* End) {
+    struct timespec now;
+    long long ns;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    ns = (long long)(End->tv_sec - now.tv_sec) * 1000000000LL + (End->tv_nsec - now.tv_nsec);
+    if (ns <= 0) return 0;
+    return (int)((ns + 999999) / 1000000);
+}
+
+// Wait for the job of a claimed engine, release ap_done and the claim.
+// Sleeps on the UIO fd when the ap_done interrupt reaches it (GIE and IER
+// bit 0 set), otherwise polls ap_done and yields the CPU in between.
+// TimeoutMs < 0 waits forever. On XST_TIMEOUT / XST_FAILURE the engine
+// stays claimed and the call can be repeated.
+int XMemcopy_accel_Complete(XMemcopy_accel *InstancePtr, int TimeoutMs) {
+    struct timespec end;
+    int irq, left, ret;
+
+    assert(InstancePtr != NULL);
+    assert(InstancePtr->Claimed);
+
+    irq = (XMemcopy_accel_ReadReg(InstancePtr->Ctrl_bus_BaseAddress, XMEMCOPY_ACCEL_CTRL_BUS_ADDR_GIE) & 0x1) &&
+          (XMemcopy_accel_InterruptGetEnabled(InstancePtr) & 0x1);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (TimeoutMs > 0) {
+        end.tv_sec += TimeoutMs / 1000;
+        end.tv_nsec += (long)(TimeoutMs % 1000) * 1000000L;
+        if (end.tv_nsec >= 1000000000L) {
+            end.tv_sec++;
+            end.tv_nsec -= 1000000000L;
+        }
+    }
+    while (!XMemcopy_accel_IsDone(InstancePtr)) {
+        left = TimeoutMs < 0 ? -1 : ms_left(&end);
+        if (irq) {
+            ret = XMemcopy_accel_WaitIrq(InstancePtr, left);
+            if (ret != XST_SUCCESS) return ret;
+        } else {
+            if (left == 0) return XST_TIMEOUT;
+            sched_yield();
+        }
+    }
+    XMemcopy_accel_Continue(InstancePtr);
+    XMemcopy_accel_Unclaim(InstancePtr);
+    return XST_SUCCESS;
+}
+
+/* Buffer pools. The free list is an array of slab indices, so alloc and
+   free are O(1) and never touch the (possibly uncached) DMA memory. */
+static void pool_reset(XMemcopy_accel_Pool *PoolPtr) {
+    int i;
+
+    memset(PoolPtr, 0, sizeof(*PoolPtr));
+    PoolPtr->Fd = -1;
+    for (i = 0; i < 4; ++i) PoolPtr->SyncFd[i] = -1;
+}
+
+static int pool_init(XMemcopy_accel_Pool *PoolPtr, u32 SlabSize) {
+    u64 count;
+    u32 i;
+
+    SlabSize = (SlabSize + POOL_SLAB_ALIGN - 1) & ~(u32)(POOL_SLAB_ALIGN - 1);
+    count = SlabSize ? PoolPtr->Size / SlabSize : 0;
+    if (count == 0 || count > 0xFFFFFFFEu) {
+        XMemcopy_accel_PoolClose(PoolPtr);
+        return XST_FAILURE;
+    }
+    PoolPtr->Next = malloc(count * sizeof(u32));
+    if (!PoolPtr->Next) {
+        XMemcopy_accel_PoolClose(PoolPtr);
+        return XST_FAILURE;
+    }
+    for (i = 0; i < count; ++i) PoolPtr->Next[i] = i + 1;
+    PoolPtr->SlabSize = SlabSize;
+    PoolPtr->SlabCount = (u32)count;
+    PoolPtr->FreeHead = 0;
+    PoolPtr->FreeCount = (u32)count;
+    return XST_SUCCESS;
+}
+
+static int pool_sync(XMemcopy_accel_Pool *PoolPtr, XMemcopy_accel_Buf *BufPtr, u32 Offset, u32 Length, int Which) {
+    char line[ MAX_UIO_NAME_SIZE ];
+    int n;
+
+    if (PoolPtr->SyncFd[Which] < 0) {
+        // uncached mapping: only order the CPU accesses against the doorbell
+        __sync_synchronize();
+        return XST_SUCCESS;
+    }
+    n = sprintf(line, "%" PRIu64, (u64)((u8*)BufPtr->Virt - PoolPtr->Virt) + Offset);
+    if (pwrite(PoolPtr->SyncFd[POOL_SYNC_OFFSET], line, n, 0) != n) return XST_FAILURE;
+    n = sprintf(line, "%u", Length);
+    if (pwrite(PoolPtr->SyncFd[POOL_SYNC_SIZE], line, n, 0) != n) return XST_FAILURE;
+    if (pwrite(PoolPtr->SyncFd[Which], "1", 1, 0) != 1) return XST_FAILURE;
+    return XST_SUCCESS;
+}
+
+// Pool on uioN/map<MapIndex> (map0 is the register space), e.g. a
+// reserved-memory node listed as a second reg of the UIO device. Call
+// after XMemcopy_accel_Initialize().
+int XMemcopy_accel_PoolOpenUio(XMemcopy_accel_Pool *PoolPtr, XMemcopy_accel *InstancePtr, int MapIndex, u32 SlabSize) {
+    XMemcopy_accel_uio_info *InfoPtr;
+    void *virt;
+
+    assert(PoolPtr != NULL);
+    assert(InstancePtr != NULL);
+    assert(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+    InfoPtr = InstancePtr->Uio;
+    pool_reset(PoolPtr);
+    if (MapIndex <= 0 || MapIndex >= MAX_UIO_MAPS || InfoPtr->maps[MapIndex].size == 0)
+        return XST_DEVICE_NOT_FOUND;
+
+    virt = mmap(NULL, InfoPtr->maps[MapIndex].size, PROT_READ|PROT_WRITE, MAP_SHARED, InfoPtr->uio_fd, MapIndex * getpagesize());
+    if (virt == MAP_FAILED)
+        return XST_OPEN_DEVICE_FAILED;
+    PoolPtr->Virt = virt;
+    PoolPtr->Phys = InfoPtr->maps[MapIndex].addr;
+    PoolPtr->Size = InfoPtr->maps[MapIndex].size;
+    return pool_init(PoolPtr, SlabSize);
+}
+
+// Pool on a u-dma-buf device (/dev/<DeviceName>), a CMA region the
+// kernel module allocates at load time. The mapping is cached; the
+// PoolSync calls go through the device's sysfs sync attributes.
+int XMemcopy_accel_PoolOpenUdmabuf(XMemcopy_accel_Pool *PoolPtr, const char* DeviceName, u32 SlabSize) {
+    char file[ MAX_UIO_PATH_SIZE ];
+    char line[ MAX_UIO_NAME_SIZE ];
+    const char *dir = NULL;
+    void *virt;
+    int i;
+
+    assert(PoolPtr != NULL);
+    assert(DeviceName != NULL);
+
+    pool_reset(PoolPtr);
+    for (i = 0; i < 2 && !dir; ++i) {
+        snprintf(file, sizeof(file), "%s/%s/phys_addr", udmabuf_class[i], DeviceName);
+        if (line_from_file(file, line) == 0) dir = udmabuf_class[i];
+    }
+    if (!dir) return XST_DEVICE_NOT_FOUND;
+    PoolPtr->Phys = strtoull(line, NULL, 0);
+    snprintf(file, sizeof(file), "%s/%s/size", dir, DeviceName);
+    if (line_from_file(file, line) != 0) return XST_DEVICE_NOT_FOUND;
+    PoolPtr->Size = strtoull(line, NULL, 0);
+
+    // Bidirectional: the same calls serve source and destination buffers
+    snprintf(file, sizeof(file), "%s/%s/sync_direction", dir, DeviceName);
+    if ((i = open(file, O_WRONLY)) >= 0) {
+        // not fatal: the module default is bidirectional as well
+        if (write(i, "0", 1) != 1) fprintf(stderr, "%s: direction not set\n", file);
+        close(i);
+    }
+    for (i = 0; i < 4; ++i) {
+        snprintf(file, sizeof(file), "%s/%s/%s", dir, DeviceName, udmabuf_sync[i]);
+        if ((PoolPtr->SyncFd[i] = open(file, O_WRONLY)) < 0) {
+            XMemcopy_accel_PoolClose(PoolPtr);
+            return XST_OPEN_DEVICE_FAILED;
+        }
+    }
+
+    snprintf(file, sizeof(file), "/dev/%s", DeviceName);
+    if ((PoolPtr->Fd = open(file, O_RDWR)) < 0) {
+        XMemcopy_accel_PoolClose(PoolPtr);
+        return XST_OPEN_DEVICE_FAILED;
+    }
+    virt = mmap(NULL, PoolPtr->Size, PROT_READ|PROT_WRITE, MAP_SHARED, PoolPtr->Fd, 0);
+    if (virt == MAP_FAILED) {
+        XMemcopy_accel_PoolClose(PoolPtr);
+        return XST_OPEN_DEVICE_FAILED;
+    }
+    PoolPtr->Virt = virt;
+    return pool_init(PoolPtr, SlabSize);
+}
+
+void XMemcopy_accel_PoolClose(XMemcopy_accel_Pool *PoolPtr) {
+    int i;
+
+    assert(PoolPtr != NULL);
+
+    if (PoolPtr->Virt) munmap(PoolPtr->Virt, PoolPtr->Size);
+    if (PoolPtr->Fd >= 0) close(PoolPtr->Fd);
+    for (i = 0; i < 4; ++i) {
+        if (PoolPtr->SyncFd[i] >= 0) close(PoolPtr->SyncFd[i]);
+    }
+    free(PoolPtr->Next);
+    pool_reset(PoolPtr);
+}
+
+// Take one slab. Returns XST_FAILURE when the pool is empty.
+int XMemcopy_accel_PoolAlloc(XMemcopy_accel_Pool *PoolPtr, XMemcopy_accel_Buf *BufPtr) {
+    u32 idx;
+
+    assert(PoolPtr != NULL);
+    assert(BufPtr != NULL);
+
+    idx = PoolPtr->FreeHead;
+    if (idx >= PoolPtr->SlabCount) return XST_FAILURE;
+    PoolPtr->FreeHead = PoolPtr->Next[idx];
+    PoolPtr->FreeCount--;
+
+    BufPtr->Virt = PoolPtr->Virt + (u64)idx * PoolPtr->SlabSize;
+    BufPtr->Phys = PoolPtr->Phys + (u64)idx * PoolPtr->SlabSize;
+    BufPtr->Size = PoolPtr->SlabSize;
+    return XST_SUCCESS;
+}
+
+void XMemcopy_accel_PoolFree(XMemcopy_accel_Pool *PoolPtr, XMemcopy_accel_Buf *BufPtr) {
+    u64 off;
+    u32 idx;
+
+    assert(PoolPtr != NULL);
+    assert(BufPtr != NULL && BufPtr->Virt != NULL);
+
+    off = (u64)((u8*)BufPtr->Virt - PoolPtr->Virt);
+    idx = (u32)(off / PoolPtr->SlabSize);
+    assert(off % PoolPtr->SlabSize == 0 && idx < PoolPtr->SlabCount);
+
+    PoolPtr->Next[idx] = PoolPtr->FreeHead;
+    PoolPtr->FreeHead = idx;
+    PoolPtr->FreeCount++;
+    BufPtr->Virt = NULL;
+}
+
+// Hand Length bytes at Offset of the buffer to the IP: write back the
+// CPU's dirty lines (source data, and the destination so no dirty line is
+// evicted over the result later)
+int XMemcopy_accel_PoolSyncForDevice(XMemcopy_accel_Pool *PoolPtr, XMemcopy_accel_Buf *BufPtr, u32 Offset, u32 Length) {
+    assert(PoolPtr != NULL);
+    assert(BufPtr != NULL && Offset + (u64)Length <= BufPtr->Size);
+
+    return pool_sync(PoolPtr, BufPtr, Offset, Length, POOL_SYNC_FOR_DEVICE);
+}
+
+// Take Length bytes at Offset back after the IP wrote them: drop the
+// stale lines
+int XMemcopy_accel_PoolSyncForCpu(XMemcopy_accel_Pool *PoolPtr, XMemcopy_accel_Buf *BufPtr, u32 Offset, u32 Length) {
+    assert(PoolPtr != NULL);
+    assert(BufPtr != NULL && Offset + (u64)Length <= BufPtr->Size);
+
+    return pool_sync(PoolPtr, BufPtr, Offset, Length, POOL_SYNC_FOR_CPU);
+}
+
 #endif
@@ -11,6 +11,7 @@
 //        bit 1  - ap_done (Read/COR)
 //        bit 2  - ap_idle (Read)
 //        bit 3  - ap_ready (Read/COR)
+//        bit 4  - ap_continue (Read/Write/SC)
 //        bit 7  - auto_restart (Read/Write)
 //        bit 9  - interrupt (Read)
 //        others - reserved
@@ -37,17 +38,165 @@
 // 0x24 : reserved
 // 0x28 : Data signal of len
 //        bit 31~0 - len[31:0] (Read/Write)
-// 0x2c : reserved
+// 0x2c : Data signal of len
+//        bit 31~0 - len[63:32] (Read/Write)
+// 0x30 : reserved
+// 0x34 : Data signal of src_off
+//        bit 31~0 - src_off[31:0] (Read/Write)
+// 0x38 : reserved
+// 0x3c : Data signal of dst_off
+//        bit 31~0 - dst_off[31:0] (Read/Write)
+// 0x40 : reserved
+// 0x44 : Data signal of dst_bytes
+//        bit 31~0 - dst_bytes[31:0] (Read/Write)
+// 0x48 : Data signal of dst_bytes
+//        bit 31~0 - dst_bytes[63:32] (Read/Write)
+// 0x4c : reserved
+// 0x50 : Data signal of op
+//        bit 31~0 - op[31:0] (Read/Write)
+// 0x54 : reserved
+// 0x58 : Data signal of desc
+//        bit 31~0 - desc[31:0] (Read/Write)
+// 0x5c : Data signal of desc
+//        bit 31~0 - desc[63:32] (Read/Write)
+// 0x60 : reserved
+// 0x64 : Data signal of rows
+//        bit 31~0 - rows[31:0] (Read/Write)
+// 0x68 : reserved
+// 0x6c : Data signal of row_bytes
+//        bit 31~0 - row_bytes[31:0] (Read/Write)
+// 0x70 : reserved
+// 0x74 : Data signal of src_stride
+//        bit 31~0 - src_stride[31:0] (Read/Write)
+// 0x78 : reserved
+// 0x7c : Data signal of dst_stride
+//        bit 31~0 - dst_stride[31:0] (Read/Write)
+// 0x80 : reserved
+// 0x84 : Data signal of fill
+//        bit 31~0 - fill[31:0] (Read/Write)
+// 0x88 : reserved
+// 0x8c : Data signal of crc
+//        bit 31~0 - crc[31:0] (Read)
+// 0x90 : Control signal of crc
+//        bit 0  - crc_ap_vld (Read/COR)
+//        others - reserved
+// 0x94 : Data signal of cmp_match
+//        bit 31~0 - cmp_match[31:0] (Read)
+// 0x98 : Control signal of cmp_match
+//        bit 0  - cmp_match_ap_vld (Read/COR)
+//        others - reserved
+// 0x9c : Data signal of cmp_first
+//        bit 31~0 - cmp_first[31:0] (Read)
+// 0xa0 : Data signal of cmp_first
+//        bit 31~0 - cmp_first[63:32] (Read)
+// 0xa4 : Control signal of cmp_first
+//        bit 0  - cmp_first_ap_vld (Read/COR)
+//        others - reserved
+// 0xa8 : Data signal of cmp_count
+//        bit 31~0 - cmp_count[31:0] (Read)
+// 0xac : Data signal of cmp_count
+//        bit 31~0 - cmp_count[63:32] (Read)
+// 0xb0 : Control signal of cmp_count
+//        bit 0  - cmp_count_ap_vld (Read/COR)
+//        others - reserved
+// 0xb4 : Data signal of perf_cycles
+//        bit 31~0 - perf_cycles[31:0] (Read)
+// 0xb8 : Control signal of perf_cycles
+//        bit 0  - perf_cycles_ap_vld (Read/COR)
+//        others - reserved
+// 0xbc : Data signal of perf_rd_beats
+//        bit 31~0 - perf_rd_beats[31:0] (Read)
+// 0xc0 : Control signal of perf_rd_beats
+//        bit 0  - perf_rd_beats_ap_vld (Read/COR)
+//        others - reserved
+// 0xc4 : Data signal of perf_wr_beats
+//        bit 31~0 - perf_wr_beats[31:0] (Read)
+// 0xc8 : Control signal of perf_wr_beats
+//        bit 0  - perf_wr_beats_ap_vld (Read/COR)
+//        others - reserved
+// 0xcc : Data signal of perf_stall
+//        bit 31~0 - perf_stall[31:0] (Read)
+// 0xd0 : Control signal of perf_stall
+//        bit 0  - perf_stall_ap_vld (Read/COR)
+//        others - reserved
+// 0xd4 : Data signal of cpl
+//        bit 31~0 - cpl[31:0] (Read/Write)
+// 0xd8 : Data signal of cpl
+//        bit 31~0 - cpl[63:32] (Read/Write)
+// 0xdc : reserved
+// 0xe0 : Data signal of ring_prod
+//        bit 31~0 - ring_prod[31:0] (Read/Write)
+// 0xe4 : Data signal of ring_prod
+//        bit 31~0 - ring_prod[63:32] (Read/Write)
+// 0xe8 : reserved
+// 0xec : Data signal of irq_count
+//        bit 31~0 - irq_count[31:0] (Read/Write)
+// 0xf0 : reserved
+// 0xf4 : Data signal of irq_idle
+//        bit 31~0 - irq_idle[31:0] (Read/Write)
+// 0xf8 : reserved
 // (SC = Self Clear, COR = Clear on Read, TOW = Toggle on Write, COH = Clear on Handshake)
 
-#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_AP_CTRL  0x00
-#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_GIE      0x04
-#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_IER      0x08
-#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_ISR      0x0c
-#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_SRC_DATA 0x10
-#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_SRC_DATA 64
-#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_DATA 0x1c
-#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_DST_DATA 64
-#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_LEN_DATA 0x28
-#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_LEN_DATA 32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_AP_CTRL            0x00
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_GIE                0x04
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_IER                0x08
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_ISR                0x0c
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_SRC_DATA           0x10
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_SRC_DATA           64
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_DATA           0x1c
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_DST_DATA           64
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_LEN_DATA           0x28
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_LEN_DATA           64
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_SRC_OFF_DATA       0x34
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_SRC_OFF_DATA       32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_OFF_DATA       0x3c
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_DST_OFF_DATA       32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_BYTES_DATA     0x44
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_DST_BYTES_DATA     64
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_OP_DATA            0x50
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_OP_DATA            32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DESC_DATA          0x58
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_DESC_DATA          64
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_ROWS_DATA          0x64
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_ROWS_DATA          32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_ROW_BYTES_DATA     0x6c
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_ROW_BYTES_DATA     32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_SRC_STRIDE_DATA    0x74
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_SRC_STRIDE_DATA    32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_DST_STRIDE_DATA    0x7c
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_DST_STRIDE_DATA    32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_FILL_DATA          0x84
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_FILL_DATA          32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CRC_DATA           0x8c
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_CRC_DATA           32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CRC_CTRL           0x90
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_MATCH_DATA     0x94
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_CMP_MATCH_DATA     32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_MATCH_CTRL     0x98
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_FIRST_DATA     0x9c
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_CMP_FIRST_DATA     64
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_FIRST_CTRL     0xa4
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_COUNT_DATA     0xa8
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_CMP_COUNT_DATA     64
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CMP_COUNT_CTRL     0xb0
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_CYCLES_DATA   0xb4
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_PERF_CYCLES_DATA   32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_CYCLES_CTRL   0xb8
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_RD_BEATS_DATA 0xbc
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_PERF_RD_BEATS_DATA 32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_RD_BEATS_CTRL 0xc0
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_WR_BEATS_DATA 0xc4
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_PERF_WR_BEATS_DATA 32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_WR_BEATS_CTRL 0xc8
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_STALL_DATA    0xcc
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_PERF_STALL_DATA    32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_PERF_STALL_CTRL    0xd0
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_CPL_DATA           0xd4
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_CPL_DATA           64
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_RING_PROD_DATA     0xe0
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_RING_PROD_DATA     64
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_IRQ_COUNT_DATA     0xec
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_IRQ_COUNT_DATA     32
+#define XMEMCOPY_ACCEL_CTRL_BUS_ADDR_IRQ_IDLE_DATA      0xf4
+#define XMEMCOPY_ACCEL_CTRL_BUS_BITS_IRQ_IDLE_DATA      32
 
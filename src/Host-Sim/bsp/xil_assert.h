@@ -0,0 +1,13 @@
+/* Host stand-in for the standalone BSP xil_assert.h (src/Host-Sim) */
+#ifndef XIL_ASSERT_H
+#define XIL_ASSERT_H
+
+#include <assert.h>
+#include "xil_types.h"
+
+#define Xil_AssertVoid(Expression)      assert(Expression)
+#define Xil_AssertNonvoid(Expression)   assert(Expression)
+#define Xil_AssertVoidAlways()          assert(0)
+#define Xil_AssertNonvoidAlways()       assert(0)
+
+#endif
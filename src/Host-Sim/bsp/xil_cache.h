@@ -0,0 +1,14 @@
+/* Host stand-in for the standalone BSP xil_cache.h (src/Host-Sim).
+   The model masters share the CPU's coherent view of memory, so cache
+   maintenance reduces to a memory barrier. */
+#ifndef XIL_CACHE_H
+#define XIL_CACHE_H
+
+#include "xil_types.h"
+
+void Xil_DCacheFlushRange(INTPTR adr, u32 len);
+void Xil_DCacheInvalidateRange(INTPTR adr, u32 len);
+void Xil_DCacheFlush(void);
+void Xil_DCacheInvalidate(void);
+
+#endif
@@ -0,0 +1,18 @@
+/* Host stand-in for the standalone BSP xil_exception.h (src/Host-Sim) */
+#ifndef XIL_EXCEPTION_H
+#define XIL_EXCEPTION_H
+
+#include "xil_types.h"
+
+#define XIL_EXCEPTION_ID_IRQ_INT    5U
+#define XIL_EXCEPTION_ID_INT        XIL_EXCEPTION_ID_IRQ_INT
+
+typedef void (*Xil_ExceptionHandler)(void *data);
+typedef void (*Xil_InterruptHandler)(void *data);
+
+void Xil_ExceptionInit(void);
+void Xil_ExceptionRegisterHandler(u32 Exception_id, Xil_ExceptionHandler Handler, void *Data);
+void Xil_ExceptionEnable(void);
+void Xil_ExceptionDisable(void);
+
+#endif
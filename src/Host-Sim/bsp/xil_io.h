@@ -0,0 +1,13 @@
+/* Host stand-in for the standalone BSP xil_io.h (src/Host-Sim).
+   Accesses inside an accelerator's CTRL_BUS window go to the register
+   model (memcopy_model.h); anything else is plain host memory. Reads also
+   give pending interrupts a chance to be taken, as on the CPU. */
+#ifndef XIL_IO_H
+#define XIL_IO_H
+
+#include "xil_types.h"
+
+u32 Xil_In32(UINTPTR Addr);
+void Xil_Out32(UINTPTR Addr, u32 Value);
+
+#endif
@@ -0,0 +1,7 @@
+/* Host stand-in for the standalone BSP xil_printf.h (src/Host-Sim) */
+#ifndef XIL_PRINTF_H
+#define XIL_PRINTF_H
+
+void xil_printf(const char *ctrl1, ...) __attribute__((format(printf, 1, 2)));
+
+#endif
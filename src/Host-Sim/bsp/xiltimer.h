@@ -0,0 +1,15 @@
+/* Host stand-in for the SDT xiltimer.h (src/Host-Sim): the global timer
+   counts at the A9's 333 MHz from CLOCK_MONOTONIC */
+#ifndef XILTIMER_H
+#define XILTIMER_H
+
+#include "xil_types.h"
+#include "xparameters.h"
+
+typedef u64 XTime;
+
+#define COUNTS_PER_SECOND   (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2)
+
+void XTime_GetTime(XTime *Xtime_Global);
+
+#endif
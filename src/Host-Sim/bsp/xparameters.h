@@ -0,0 +1,25 @@
+/* Host xparameters.h (src/Host-Sim): memcopy_accel_0 at the board
+   design's address plus a second instance, so the multi-channel paths of
+   main.c are built and run as well. Interrupts are the GIC IDs of
+   IRQ_F2P[0] and [1]. */
+#ifndef XPARAMETERS_H
+#define XPARAMETERS_H
+
+#define XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ 666666687ULL
+
+#define XPAR_SCUGIC_SINGLE_DEVICE_ID 0
+#define XPAR_SCUGIC_0_CPU_BASEADDR 0xF8F00100U
+#define XPAR_SCUGIC_0_DIST_BASEADDR 0xF8F01000U
+
+#define XPAR_XMEMCOPY_ACCEL_NUM_INSTANCES 2
+
+#define XPAR_MEMCOPY_ACCEL_0_BASEADDR 0x40000000
+#define XPAR_MEMCOPY_ACCEL_0_HIGHADDR 0x4000ffff
+#define XPAR_FABRIC_MEMCOPY_ACCEL_0_INTR 61
+#define XPAR_FABRIC_MEMCOPY_ACCEL_0_INTERRUPT_INTR XPAR_FABRIC_MEMCOPY_ACCEL_0_INTR
+
+#define XPAR_MEMCOPY_ACCEL_1_BASEADDR 0x40010000
+#define XPAR_MEMCOPY_ACCEL_1_HIGHADDR 0x4001ffff
+#define XPAR_FABRIC_MEMCOPY_ACCEL_1_INTR 62
+
+#endif
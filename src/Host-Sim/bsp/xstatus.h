@@ -0,0 +1,12 @@
+/* Host stand-in for the standalone BSP xstatus.h (src/Host-Sim) */
+#ifndef XSTATUS_H
+#define XSTATUS_H
+
+#include "xil_types.h"
+
+#define XST_SUCCESS             0L
+#define XST_FAILURE             1L
+#define XST_DEVICE_NOT_FOUND    2L
+#define XST_DEVICE_BUSY         21L
+
+#endif
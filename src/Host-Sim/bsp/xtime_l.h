@@ -0,0 +1,7 @@
+/* Host stand-in for the classic-flow xtime_l.h (src/Host-Sim) */
+#ifndef XTIME_H
+#define XTIME_H
+
+#include "xiltimer.h"
+
+#endif
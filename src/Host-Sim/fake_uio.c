@@ -0,0 +1,517 @@
+/* Fake UIO tree and register-file emulator, see fake_uio.h.
+ *
+ * The registers are plain shared memory that the driver loads and stores
+ * directly, so the model thread cannot see individual accesses. It polls
+ * AP_CTRL and plays the IP side of the handshake with compare-and-swap,
+ * which fails and retries if the driver stored to AP_CTRL in between:
+ *   ap_start     latch the arguments, clear ap_start (kept by
+ *                auto_restart) and ap_done/ap_idle, run the HLS top
+ *                function (memcopy_model_execute()), write the outputs,
+ *                set ap_done and, without ap_ctrl_chain, ap_idle
+ *   ap_continue  clear it, and set ap_idle if ap_done was held or
+ *                without ap_ctrl_chain
+ *   ISR          bit 1 at the latch, bit 0 at the end, if set in IER;
+ *                each one raises the interrupt if GIE is set
+ * What memory cannot do is not emulated: ap_done and the _ap_vld bits are
+ * not cleared on read (the driver's own AP_CTRL stores drop ap_done), and
+ * a write to ISR does not toggle it. The model clears ISR when it latches
+ * the next start instead, which is what XMemcopy_accel_AckIrq() would have
+ * done by then. ap_continue is not self-clearing either, so the driver's
+ * next XMemcopy_accel_Start() store may overwrite it before the model saw
+ * it: an ap_start while ap_done is held counts as that ap_continue. A
+ * driver that never continues does not hang here as it would on the IP.
+ *
+ * The interrupt is that of uio_pdrv_genirq. The link wraps open, close,
+ * read, write, poll and epoll_ctl (fake_uio.h); on an fd the driver opened
+ * on a tree device they act on the device's eventfd instead of the file:
+ *   read(4)      block until an interrupt, return the interrupt count
+ *   write(4)     irqcontrol: 1 unmasks the line, 0 masks it
+ *   poll         POLLIN once an interrupt is pending
+ *   epoll_ctl    the epoll set watches the eventfd, EPOLLIN likewise
+ * An interrupt masks the line until the next unmask, and one raised while
+ * masked is delivered at the unmask. Other fds go to the C library.
+ */
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "xmemcopy_accel_hw.h"
+#include "memcopy_model.h"
+#include "fake_uio.h"
+
+#define REG(name)           (XMEMCOPY_ACCEL_CTRL_BUS_ADDR_##name / 4)
+
+#define AP_START            0x001u
+#define AP_DONE             0x002u
+#define AP_IDLE             0x004u
+#define AP_CONTINUE         0x010u
+#define AUTO_RESTART        0x080u
+
+#define FAKE_UIO_SPIN       1024    /* empty polls before yielding the CPU */
+#define FAKE_UIO_YIELD      65536   /* ... and before sleeping between polls */
+#define FAKE_UIO_SLEEP_NS   100000
+#define FAKE_UIO_MAX_FDS    1024    /* fds that can stand for a device */
+#define FAKE_UIO_MAX_POLL   16      /* pollfds translated per poll() call */
+
+struct fake_dev {
+    fake_uio *tree;
+    int num;
+    uint8_t *map;               /* the whole file: registers, then DMA */
+    size_t map_len;
+    uint32_t *regs;
+    int model;
+    pthread_t thread;
+    uint64_t jobs;
+    char path[160];             /* <root>/dev/uioN */
+    int irq_fd;                 /* eventfd: readable while an interrupt is pending */
+    pthread_mutex_t irq_lock;
+    int masked;                 /* irqcontrol 0, or an interrupt not yet unmasked */
+    int pending;                /* raised while masked */
+    uint32_t irqs;              /* interrupts delivered, the UIO event count */
+};
+
+struct fake_uio {
+    char root[96];
+    char sysfs[128];
+    char dev[128];
+    struct fake_dev devs[FAKE_UIO_MAX_DEVICES];
+    int count;
+    int stop;
+};
+
+/* Real C library calls, see the wrappers at the end */
+int __real_open(const char *path, int flags, ...);
+int __real_close(int fd);
+ssize_t __real_read(int fd, void *buf, size_t count);
+ssize_t __real_write(int fd, const void *buf, size_t count);
+int __real_poll(struct pollfd *fds, nfds_t nfds, int timeout);
+int __real_epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+
+static fake_uio *active;                            /* the tree the wrappers serve */
+static struct fake_dev *fd_dev[FAKE_UIO_MAX_FDS];   /* fd -> device, NULL for other files */
+
+static int write_file(const char *path, const char *line)
+{
+    FILE *fp = fopen(path, "w");
+
+    if (!fp)
+        return -1;
+    fprintf(fp, "%s\n", line);
+    return fclose(fp);
+}
+
+static int write_map(const char *dir, int n, uint64_t addr, size_t size)
+{
+    char path[256], line[32];
+
+    snprintf(path, sizeof(path), "%s/maps/map%d", dir, n);
+    if (mkdir(path, 0755) < 0)
+        return -1;
+    snprintf(path, sizeof(path), "%s/maps/map%d/addr", dir, n);
+    snprintf(line, sizeof(line), "0x%016llx", (unsigned long long)addr);
+    if (write_file(path, line) < 0)
+        return -1;
+    snprintf(path, sizeof(path), "%s/maps/map%d/size", dir, n);
+    snprintf(line, sizeof(line), "0x%08llx", (unsigned long long)size);
+    return write_file(path, line);
+}
+
+static uint32_t load(uint32_t *reg)
+{
+    return __atomic_load_n(reg, __ATOMIC_ACQUIRE);
+}
+
+static int swap(uint32_t *reg, uint32_t *expected, uint32_t value)
+{
+    return __atomic_compare_exchange_n(reg, expected, value, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+/* Deliver an interrupt: mask the line and wake the reader (irq_lock held) */
+static void fake_uio_fire(struct fake_dev *d)
+{
+    uint64_t one = 1;
+
+    d->masked = 1;
+    d->pending = 0;
+    __atomic_fetch_add(&d->irqs, 1, __ATOMIC_RELAXED);
+    if (__real_write(d->irq_fd, &one, sizeof(one)) != sizeof(one))
+        perror("fake_uio: eventfd");
+}
+
+/* An ISR bit went up: the line goes high if GIE is set */
+static void fake_uio_raise(struct fake_dev *d)
+{
+    if (!(load(&d->regs[REG(GIE)]) & 0x1))
+        return;
+    pthread_mutex_lock(&d->irq_lock);
+    if (d->masked)
+        d->pending = 1;
+    else
+        fake_uio_fire(d);
+    pthread_mutex_unlock(&d->irq_lock);
+}
+
+static void fake_uio_irqcontrol(struct fake_dev *d, int enable)
+{
+    pthread_mutex_lock(&d->irq_lock);
+    d->masked = !enable;
+    if (enable && d->pending)
+        fake_uio_fire(d);
+    pthread_mutex_unlock(&d->irq_lock);
+}
+
+/* Returns IER as latched: ISR bit 0 is set by the caller with ap_done */
+static uint32_t fake_uio_run(struct fake_dev *d)
+{
+    uint32_t *regs = d->regs;
+    uint32_t r[MEMCOPY_MODEL_NUM_REGS];
+    uint32_t ier, i;
+
+    for (i = 0; i < MEMCOPY_MODEL_NUM_REGS; ++i)
+        r[i] = __atomic_load_n(&regs[i], __ATOMIC_RELAXED);
+    ier = r[REG(IER)];
+    __atomic_store_n(&regs[REG(ISR)], ier & 0x2, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&d->jobs, 1, __ATOMIC_RELAXED);
+    if (ier & 0x2)
+        fake_uio_raise(d);
+
+    memcopy_model_execute(r);
+
+    /* cmp_* come back unchanged from a run that is not a compare */
+    for (i = REG(CRC_DATA); i < REG(CPL_DATA); ++i)
+        __atomic_store_n(&regs[i], r[i], __ATOMIC_RELAXED);
+    return ier;
+}
+
+static void *fake_uio_model(void *arg)
+{
+    struct fake_dev *d = arg;
+    uint32_t *ctrl = &d->regs[REG(AP_CTRL)];
+    int chain = memcopy_model_ctrl_chain();
+    int held = 0;
+    unsigned polls = 0;
+
+    while (!__atomic_load_n(&d->tree->stop, __ATOMIC_ACQUIRE)) {
+        uint32_t v = load(ctrl);
+
+        if (v & AP_CONTINUE) {
+            /* the driver's store may have dropped the ap_idle an
+               ap_ctrl_hs run left set, so set it again */
+            if (swap(ctrl, &v, (v & ~AP_CONTINUE) | (held || !chain ? AP_IDLE : 0))) {
+                held = 0;
+                polls = 0;
+            }
+            continue;
+        }
+        if (v & AP_START) {
+            uint32_t keep = v & AUTO_RESTART, ier;
+
+            if (!swap(ctrl, &v, keep | (keep ? AP_START : 0)))
+                continue;
+            ier = fake_uio_run(d);
+            held = chain;
+            __atomic_fetch_or(ctrl, AP_DONE | (chain ? 0 : AP_IDLE), __ATOMIC_RELEASE);
+            /* after ap_done, so a woken driver finds it set */
+            if (ier & 0x1) {
+                __atomic_fetch_or(&d->regs[REG(ISR)], 0x1, __ATOMIC_RELEASE);
+                fake_uio_raise(d);
+            }
+            polls = 0;
+            continue;
+        }
+
+        if (++polls < FAKE_UIO_SPIN) {
+            continue;
+        } else if (polls < FAKE_UIO_YIELD) {
+            sched_yield();
+        } else {
+            struct timespec ts = { 0, FAKE_UIO_SLEEP_NS };
+            nanosleep(&ts, NULL);
+        }
+    }
+    return NULL;
+}
+
+fake_uio *fake_uio_create(void)
+{
+    const char *tmp = getenv("TMPDIR");
+    fake_uio *tree = calloc(1, sizeof(*tree));
+    char path[160];
+
+    if (!tree)
+        return NULL;
+    if (!tmp || !*tmp || strlen(tmp) > 64)
+        tmp = "/tmp";
+    snprintf(tree->root, sizeof(tree->root), "%s/fake_uio.XXXXXX", tmp);
+    if (!mkdtemp(tree->root)) {
+        free(tree);
+        return NULL;
+    }
+    snprintf(tree->sysfs, sizeof(tree->sysfs), "%s/sys/class/uio", tree->root);
+    snprintf(tree->dev, sizeof(tree->dev), "%s/dev", tree->root);
+    snprintf(path, sizeof(path), "%s/sys", tree->root);
+    mkdir(path, 0755);
+    snprintf(path, sizeof(path), "%s/sys/class", tree->root);
+    mkdir(path, 0755);
+    if (mkdir(tree->sysfs, 0755) < 0 || mkdir(tree->dev, 0755) < 0) {
+        fake_uio_destroy(tree);
+        return NULL;
+    }
+    active = tree;
+    return tree;
+}
+
+int fake_uio_add(fake_uio *tree, int num, const char *name, size_t dma_size, int model)
+{
+    struct fake_dev *d;
+    size_t page = (size_t)getpagesize();
+    char dir[192], path[256];
+    int fd;
+
+    if (tree->count == FAKE_UIO_MAX_DEVICES)
+        return -1;
+    d = &tree->devs[tree->count];
+    memset(d, 0, sizeof(*d));
+    d->tree = tree;
+    d->num = num;
+
+    /* map0 is the register page, map1 starts one page in. The device is
+       not counted yet, so this open is not taken for the driver's. */
+    snprintf(d->path, sizeof(d->path), "%s/uio%d", tree->dev, num);
+    fd = open(d->path, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0)
+        return -1;
+    d->map_len = page + ((dma_size + page - 1) & ~(page - 1));
+    if (ftruncate(fd, (off_t)d->map_len) < 0) {
+        close(fd);
+        return -1;
+    }
+    d->map = mmap(NULL, d->map_len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (d->map == MAP_FAILED)
+        return -1;
+    d->irq_fd = eventfd(0, EFD_CLOEXEC);
+    if (d->irq_fd < 0) {
+        munmap(d->map, d->map_len);
+        return -1;
+    }
+    pthread_mutex_init(&d->irq_lock, NULL);
+    d->regs = (uint32_t *)d->map;
+    d->regs[REG(AP_CTRL)] = AP_IDLE;
+
+    snprintf(dir, sizeof(dir), "%s/uio%d", tree->sysfs, num);
+    if (mkdir(dir, 0755) < 0)
+        goto fail;
+    snprintf(path, sizeof(path), "%s/name", dir);
+    if (write_file(path, name) < 0)
+        goto fail;
+    snprintf(path, sizeof(path), "%s/version", dir);
+    if (write_file(path, "devicetree") < 0)
+        goto fail;
+    snprintf(path, sizeof(path), "%s/maps", dir);
+    if (mkdir(path, 0755) < 0 || write_map(dir, 0, 0x43c00000u + 0x10000u * (unsigned)num, page) < 0)
+        goto fail;
+    if (dma_size && write_map(dir, 1, (uintptr_t)(d->map + page), dma_size) < 0)
+        goto fail;
+
+    if (model) {
+        if (pthread_create(&d->thread, NULL, fake_uio_model, d) != 0)
+            goto fail;
+        d->model = 1;
+    }
+    tree->count++;
+    return 0;
+
+fail:
+    __real_close(d->irq_fd);
+    pthread_mutex_destroy(&d->irq_lock);
+    munmap(d->map, d->map_len);
+    return -1;
+}
+
+const char *fake_uio_sysfs(const fake_uio *tree)
+{
+    return tree->sysfs;
+}
+
+const char *fake_uio_dev(const fake_uio *tree)
+{
+    return tree->dev;
+}
+
+uint64_t fake_uio_jobs(fake_uio *tree, int num)
+{
+    for (int i = 0; i < tree->count; ++i) {
+        if (tree->devs[i].num == num)
+            return __atomic_load_n(&tree->devs[i].jobs, __ATOMIC_RELAXED);
+    }
+    return 0;
+}
+
+uint32_t fake_uio_irqs(fake_uio *tree, int num)
+{
+    for (int i = 0; i < tree->count; ++i) {
+        if (tree->devs[i].num == num)
+            return __atomic_load_n(&tree->devs[i].irqs, __ATOMIC_RELAXED);
+    }
+    return 0;
+}
+
+static int remove_entry(const char *path, const struct stat *st, int flag, struct FTW *ftw)
+{
+    (void)st;
+    (void)flag;
+    (void)ftw;
+    return remove(path);
+}
+
+void fake_uio_destroy(fake_uio *tree)
+{
+    if (!tree)
+        return;
+    __atomic_store_n(&tree->stop, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < tree->count; ++i) {
+        if (tree->devs[i].model)
+            pthread_join(tree->devs[i].thread, NULL);
+        __real_close(tree->devs[i].irq_fd);
+        pthread_mutex_destroy(&tree->devs[i].irq_lock);
+        munmap(tree->devs[i].map, tree->devs[i].map_len);
+    }
+    if (active == tree)
+        active = NULL;
+    nftw(tree->root, remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+    free(tree);
+}
+
+/* The device fd stands for, or NULL */
+static struct fake_dev *fake_uio_fd(int fd)
+{
+    if (fd < 0 || fd >= FAKE_UIO_MAX_FDS)
+        return NULL;
+    return __atomic_load_n(&fd_dev[fd], __ATOMIC_ACQUIRE);
+}
+
+int fake_uio_fd_num(int fd)
+{
+    struct fake_dev *d = fake_uio_fd(fd);
+
+    return d ? d->num : -1;
+}
+
+int __wrap_open(const char *path, int flags, ...)
+{
+    struct fake_dev *d = NULL;
+    mode_t mode = 0;
+    va_list ap;
+    int fd;
+
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        va_start(ap, flags);
+        mode = va_arg(ap, mode_t);
+        va_end(ap);
+    }
+    fd = __real_open(path, flags, mode);
+    if (fd < 0 || !active)
+        return fd;
+    for (int i = 0; i < active->count && !d; ++i) {
+        if (strcmp(path, active->devs[i].path) == 0)
+            d = &active->devs[i];
+    }
+    if (!d)
+        return fd;
+    if (fd >= FAKE_UIO_MAX_FDS) {
+        __real_close(fd);
+        errno = EMFILE;
+        return -1;
+    }
+    __atomic_store_n(&fd_dev[fd], d, __ATOMIC_RELEASE);
+    return fd;
+}
+
+int __wrap_close(int fd)
+{
+    if (fake_uio_fd(fd))
+        __atomic_store_n(&fd_dev[fd], NULL, __ATOMIC_RELEASE);
+    return __real_close(fd);
+}
+
+ssize_t __wrap_read(int fd, void *buf, size_t count)
+{
+    struct fake_dev *d = fake_uio_fd(fd);
+    uint64_t events;
+    uint32_t irqs;
+
+    if (!d)
+        return __real_read(fd, buf, count);
+    if (count != sizeof(irqs)) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (__real_read(d->irq_fd, &events, sizeof(events)) != sizeof(events))
+        return -1;
+    irqs = __atomic_load_n(&d->irqs, __ATOMIC_RELAXED);
+    memcpy(buf, &irqs, sizeof(irqs));
+    return sizeof(irqs);
+}
+
+ssize_t __wrap_write(int fd, const void *buf, size_t count)
+{
+    struct fake_dev *d = fake_uio_fd(fd);
+    uint32_t enable;
+
+    if (!d)
+        return __real_write(fd, buf, count);
+    if (count != sizeof(enable)) {
+        errno = EINVAL;
+        return -1;
+    }
+    memcpy(&enable, buf, sizeof(enable));
+    fake_uio_irqcontrol(d, enable != 0);
+    return sizeof(enable);
+}
+
+int __wrap_poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+    struct pollfd sub[FAKE_UIO_MAX_POLL];
+    int ret, any = 0;
+
+    if (nfds > FAKE_UIO_MAX_POLL)
+        return __real_poll(fds, nfds, timeout);
+    for (nfds_t i = 0; i < nfds; ++i) {
+        struct fake_dev *d = fake_uio_fd(fds[i].fd);
+
+        sub[i] = fds[i];
+        if (d) {
+            sub[i].fd = d->irq_fd;
+            any = 1;
+        }
+    }
+    if (!any)
+        return __real_poll(fds, nfds, timeout);
+    ret = __real_poll(sub, nfds, timeout);
+    for (nfds_t i = 0; i < nfds; ++i)
+        fds[i].revents = sub[i].revents;
+    return ret;
+}
+
+/* The epoll set watches the eventfd instead, so epoll_wait() needs no
+   wrapper and reports the caller's event data as given */
+int __wrap_epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+    struct fake_dev *d = fake_uio_fd(fd);
+
+    return __real_epoll_ctl(epfd, op, d ? d->irq_fd : fd, event);
+}
@@ -0,0 +1,67 @@
+/* Fake UIO tree for running the Linux driver (xmemcopy_accel_linux.c)
+ * on a plain Linux host, see XMemcopy_accel_SetUioPaths().
+ *
+ * Under a fresh temporary directory <root>:
+ *   <root>/sys/class/uio/uioN/name, version
+ *   <root>/sys/class/uio/uioN/maps/map0/{addr,size}   register page
+ *   <root>/sys/class/uio/uioN/maps/map1/{addr,size}   DMA region, if any
+ *   <root>/dev/uioN                                   regular file
+ * The driver maps map N at N pages of the device, so the file holds the
+ * register page at offset 0 and the DMA region from one page on. The
+ * harness maps the same file: map1's addr is the harness's own address of
+ * the region, so the kernel model can use it as a bus address.
+ *
+ * A device added with a model gets a thread that plays the kernel side of
+ * the IP on the shared page (see fake_uio.c for what it emulates).
+ *
+ * A regular file has no interrupt, so the program must be linked with
+ *   -Wl,--wrap=open,--wrap=close,--wrap=read,--wrap=write,--wrap=poll,--wrap=epoll_ctl
+ * On the fd the driver opens for /dev/uioN these calls then behave as on
+ * a UIO device: read() blocks for the interrupt count, write() is
+ * irqcontrol, and poll() and an epoll set the fd was added to wait for
+ * the interrupt, which the model raises on ISR bits with GIE set. The
+ * driver runs unchanged.
+ */
+#ifndef FAKE_UIO_H
+#define FAKE_UIO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FAKE_UIO_MAX_DEVICES    16
+
+typedef struct fake_uio fake_uio;
+
+/* Create an empty tree. Returns NULL on failure (errno set). */
+fake_uio *fake_uio_create(void);
+
+/* Add uio<num> named name with a DMA map of dma_size bytes (0: map0 only).
+   With model set, a thread emulates the IP on its registers.
+   Returns 0, or -1 on failure. */
+int fake_uio_add(fake_uio *tree, int num, const char *name, size_t dma_size, int model);
+
+/* Paths to pass to XMemcopy_accel_SetUioPaths() */
+const char *fake_uio_sysfs(const fake_uio *tree);
+const char *fake_uio_dev(const fake_uio *tree);
+
+/* Jobs the model of uio<num> has started */
+uint64_t fake_uio_jobs(fake_uio *tree, int num);
+
+/* Interrupts delivered on uio<num> */
+uint32_t fake_uio_irqs(fake_uio *tree, int num);
+
+/* N of the /dev/uioN an fd is open on, or -1 */
+int fake_uio_fd_num(int fd);
+
+/* Stop the models, unmap and remove the tree */
+void fake_uio_destroy(fake_uio *tree);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,289 @@
+/* Host implementation of the standalone BSP calls used by the memcopy
+ * drivers and MemAcc2_app/main.c (headers in bsp/).
+ *
+ * Interrupts: the model raises its lines from the worker threads and
+ * signals the CPU thread (the one that enabled exceptions) with SIGUSR1.
+ * The signal handler plays the IRQ exception: it calls the handler
+ * registered for XIL_EXCEPTION_ID_INT (XScuGic_InterruptHandler), which
+ * dispatches to the handlers connected to the lines that are high. As on
+ * the A9 the ISR is not re-entered, and it is held off while exceptions
+ * are disabled and during a register access, which the model serves under
+ * a lock the ISR would take again; it then runs when the access ends or
+ * exceptions are enabled. Xil_In32() and XTime_GetTime() also look at the
+ * lines, so a level that is still high is taken even without a new edge.
+ */
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "xparameters.h"
+#include "xil_io.h"
+#include "xil_cache.h"
+#include "xil_printf.h"
+#include "xil_exception.h"
+#include "xscugic.h"
+#include "xiltimer.h"
+#include "memcopy_model.h"
+
+#define HOST_MAX_IRQ_LOOPS  16  /* handler calls per check, bounds a line stuck high */
+
+static const struct {
+    UINTPTR base;
+    u32 irq_id;
+} host_engines[] = {
+    { XPAR_MEMCOPY_ACCEL_0_BASEADDR, XPAR_FABRIC_MEMCOPY_ACCEL_0_INTR },
+#ifdef XPAR_MEMCOPY_ACCEL_1_BASEADDR
+    { XPAR_MEMCOPY_ACCEL_1_BASEADDR, XPAR_FABRIC_MEMCOPY_ACCEL_1_INTR },
+#endif
+};
+#define HOST_NUM_ENGINES    (sizeof(host_engines) / sizeof(host_engines[0]))
+
+static struct {
+    Xil_InterruptHandler handler;
+    void *ref;
+    int enabled;
+} gic_vector[XSCUGIC_MAX_NUM_INTR_INPUTS];
+
+static Xil_ExceptionHandler irq_handler;
+static void *irq_data;
+static pthread_t cpu_thread;
+static volatile sig_atomic_t irq_enabled;
+static volatile sig_atomic_t in_irq;
+static volatile sig_atomic_t in_access;     /* register access in progress */
+static volatile sig_atomic_t irq_deferred;  /* signal arrived while held off */
+static unsigned failures;       /* FAILED / ERROR lines printed */
+
+static void host_take_interrupts(void);
+
+/* Worker thread, line going high: interrupt the CPU */
+static void host_irq_hook(u32 irq_id)
+{
+    (void)irq_id;
+    if (irq_enabled)
+        pthread_kill(cpu_thread, SIGUSR1);
+}
+
+static void host_irq_signal(int sig)
+{
+    (void)sig;
+    if (in_access || in_irq || !irq_enabled)
+        irq_deferred = 1;
+    else
+        host_take_interrupts();
+}
+
+static void host_attach(void)
+{
+    static int attached;
+
+    if (attached)
+        return;
+    attached = 1;
+    memcopy_model_set_irq_hook(host_irq_hook);
+    for (u32 i = 0; i < HOST_NUM_ENGINES; ++i)
+        memcopy_model_attach(host_engines[i].base, host_engines[i].irq_id);
+}
+
+static int host_irq_pending(void)
+{
+    for (u32 i = 0; i < HOST_NUM_ENGINES; ++i) {
+        u32 id = host_engines[i].irq_id;
+        if (gic_vector[id].enabled && gic_vector[id].handler && memcopy_model_irq(id))
+            return 1;
+    }
+    return 0;
+}
+
+static void host_take_interrupts(void)
+{
+    if (!irq_enabled || in_irq || in_access || !irq_handler)
+        return;
+    in_irq = 1;
+    irq_deferred = 0;
+    for (int n = 0; n < HOST_MAX_IRQ_LOOPS && host_irq_pending(); ++n)
+        irq_handler(irq_data);
+    in_irq = 0;
+}
+
+/* The ISR runs at the end of an access that held it off */
+static void host_access_end(void)
+{
+    in_access--;
+    if (in_access == 0 && irq_deferred)
+        host_take_interrupts();
+}
+
+u32 Xil_In32(UINTPTR Addr)
+{
+    u32 value;
+
+    host_attach();
+    host_take_interrupts();
+    in_access++;
+    if (memcopy_model_claims(Addr))
+        value = memcopy_model_read(Addr);
+    else
+        value = *(volatile u32 *)Addr;
+    host_access_end();
+    return value;
+}
+
+void Xil_Out32(UINTPTR Addr, u32 Value)
+{
+    host_attach();
+    in_access++;
+    if (memcopy_model_claims(Addr))
+        memcopy_model_write(Addr, Value);
+    else
+        *(volatile u32 *)Addr = Value;
+    host_access_end();
+}
+
+void Xil_DCacheFlushRange(INTPTR adr, u32 len)
+{
+    (void)adr;
+    (void)len;
+    __sync_synchronize();
+}
+
+void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
+{
+    (void)adr;
+    (void)len;
+    __sync_synchronize();
+}
+
+void Xil_DCacheFlush(void)
+{
+    __sync_synchronize();
+}
+
+void Xil_DCacheInvalidate(void)
+{
+    __sync_synchronize();
+}
+
+void XTime_GetTime(XTime *Xtime_Global)
+{
+    struct timespec ts;
+
+    host_take_interrupts();
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    *Xtime_Global = (XTime)ts.tv_sec * COUNTS_PER_SECOND +
+                    (XTime)ts.tv_nsec * COUNTS_PER_SECOND / 1000000000u;
+}
+
+/* main.c ends in an idle loop: its closing "Demo complete." line exits the
+   process instead, with status 1 if any FAILED or ERROR line was printed */
+void xil_printf(const char *ctrl1, ...)
+{
+    char line[1024];
+    va_list args;
+
+    va_start(args, ctrl1);
+    vsnprintf(line, sizeof(line), ctrl1, args);
+    va_end(args);
+    fputs(line, stdout);
+
+    if (strstr(line, "FAILED") || strstr(line, "ERROR"))
+        failures++;
+    if (strstr(line, "Demo complete.")) {
+        fflush(stdout);
+        exit(failures ? EXIT_FAILURE : EXIT_SUCCESS);
+    }
+}
+
+void Xil_ExceptionInit(void)
+{
+}
+
+void Xil_ExceptionRegisterHandler(u32 Exception_id, Xil_ExceptionHandler Handler, void *Data)
+{
+    if (Exception_id != XIL_EXCEPTION_ID_INT)
+        return;
+    irq_handler = Handler;
+    irq_data = Data;
+}
+
+void Xil_ExceptionEnable(void)
+{
+    static int installed;
+
+    if (!installed) {
+        struct sigaction sa;
+
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = host_irq_signal;
+        sa.sa_flags = SA_RESTART;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGUSR1, &sa, NULL);
+        cpu_thread = pthread_self();
+        installed = 1;
+    }
+    irq_enabled = 1;
+    host_take_interrupts();
+}
+
+void Xil_ExceptionDisable(void)
+{
+    irq_enabled = 0;
+}
+
+XScuGic_Config *XScuGic_LookupConfig(u16 DeviceId)
+{
+    static XScuGic_Config config = {
+        XPAR_SCUGIC_SINGLE_DEVICE_ID, XPAR_SCUGIC_0_CPU_BASEADDR, XPAR_SCUGIC_0_DIST_BASEADDR
+    };
+
+    return DeviceId == config.DeviceId ? &config : NULL;
+}
+
+s32 XScuGic_CfgInitialize(XScuGic *InstancePtr, XScuGic_Config *ConfigPtr, u32 EffectiveAddr)
+{
+    (void)EffectiveAddr;
+    InstancePtr->Config = ConfigPtr;
+    InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
+    return XST_SUCCESS;
+}
+
+s32 XScuGic_Connect(XScuGic *InstancePtr, u32 Int_Id, Xil_InterruptHandler Handler, void *CallBackRef)
+{
+    (void)InstancePtr;
+    if (Int_Id >= XSCUGIC_MAX_NUM_INTR_INPUTS)
+        return XST_FAILURE;
+    gic_vector[Int_Id].handler = Handler;
+    gic_vector[Int_Id].ref = CallBackRef;
+    return XST_SUCCESS;
+}
+
+void XScuGic_Disconnect(XScuGic *InstancePtr, u32 Int_Id)
+{
+    (void)InstancePtr;
+    gic_vector[Int_Id].handler = NULL;
+    gic_vector[Int_Id].ref = NULL;
+}
+
+void XScuGic_Enable(XScuGic *InstancePtr, u32 Int_Id)
+{
+    (void)InstancePtr;
+    gic_vector[Int_Id].enabled = 1;
+}
+
+void XScuGic_Disable(XScuGic *InstancePtr, u32 Int_Id)
+{
+    (void)InstancePtr;
+    gic_vector[Int_Id].enabled = 0;
+}
+
+void XScuGic_InterruptHandler(XScuGic *InstancePtr)
+{
+    (void)InstancePtr;
+    for (u32 i = 0; i < HOST_NUM_ENGINES; ++i) {
+        u32 id = host_engines[i].irq_id;
+        if (gic_vector[id].enabled && gic_vector[id].handler && memcopy_model_irq(id))
+            gic_vector[id].handler(gic_vector[id].ref);
+    }
+}
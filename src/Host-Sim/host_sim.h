@@ -0,0 +1,11 @@
+/* Force-included into the target sources (-include host_sim.h).
+   wfi is an ARM instruction: on the host it assembles to nothing, and the
+   wait loops around it take interrupts at their XTime_GetTime() call. */
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#if !defined(__arm__) && !defined(__aarch64__)
+__asm__(".macro wfi\n.endm");
+#endif
+
+#endif
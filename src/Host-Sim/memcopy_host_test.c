@@ -0,0 +1,414 @@
+/* Host regression suite: the bare-metal driver (MemAcc2_app/memcopy_accel.c)
+ * and the generated XMemcopy_accel_* driver against the register model.
+ * Prints one line per failed check and a summary; exit status 0 = pass.
+ */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "xparameters.h"
+#include "xil_io.h"
+#include "xil_exception.h"
+#include "xscugic.h"
+#include "xiltimer.h"
+#include "xmemcopy_accel.h"
+#include "memcopy_accel.h"
+#include "memcopy_model.h"
+
+#define BUF_BYTES   8192
+#define GUARD       0x5A
+#define TIMEOUT_US  2000000u
+
+static uint8_t src[BUF_BYTES + 64] __attribute__((aligned(64)));
+static uint8_t dst[BUF_BYTES + 64] __attribute__((aligned(64)));
+static uint8_t ref[BUF_BYTES + 64] __attribute__((aligned(64)));
+static XScuGic intc;
+static int checks, failures;
+
+#define CHECK(cond, ...)                                            \
+    do {                                                            \
+        checks++;                                                   \
+        if (!(cond)) {                                              \
+            failures++;                                             \
+            printf("FAIL %s:%d: ", __func__, __LINE__);             \
+            printf(__VA_ARGS__);                                    \
+            printf("\n");                                           \
+        }                                                           \
+    } while (0)
+
+/* zlib crc32() */
+static uint32_t crc32_ref(const uint8_t *p, size_t len)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+
+    while (len--) {
+        crc ^= *p++;
+        for (int b = 0; b < 8; ++b)
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1u));
+    }
+    return ~crc;
+}
+
+static void fill_src(uint32_t seed)
+{
+    for (uint32_t i = 0; i < sizeof(src); ++i)
+        src[i] = (uint8_t)(i * 131u + seed);
+    memset(dst, GUARD, sizeof(dst));
+}
+
+/* dst[0, off) and dst[off + len, end) still hold GUARD, dst[off, off + len)
+   equals expect */
+static int dst_is(uint32_t off, const uint8_t *expect, uint32_t len)
+{
+    for (uint32_t i = 0; i < sizeof(dst); ++i) {
+        uint8_t want = (i >= off && i < off + len) ? expect[i - off] : GUARD;
+        if (dst[i] != want)
+            return 0;
+    }
+    return 1;
+}
+
+static int poll_done(XMemcopy_accel *inst)
+{
+    XTime t0, now;
+
+    XTime_GetTime(&t0);
+    while (!XMemcopy_accel_IsDone(inst)) {
+        XTime_GetTime(&now);
+        if (now - t0 > (XTime)TIMEOUT_US * (COUNTS_PER_SECOND / 1000000))
+            return 0;
+    }
+    return 1;
+}
+
+/* CTRL_BUS semantics through the generated driver, on the second engine */
+static void test_registers(void)
+{
+    XMemcopy_accel_Config cfg = { 1, XPAR_MEMCOPY_ACCEL_1_BASEADDR };
+    XMemcopy_accel inst;
+    uint32_t len = 1000;
+
+    CHECK(XMemcopy_accel_CfgInitialize(&inst, &cfg) == XST_SUCCESS, "CfgInitialize");
+    CHECK(XMemcopy_accel_IsIdle(&inst), "idle after reset");
+    CHECK(!XMemcopy_accel_IsDone(&inst), "no ap_done after reset");
+
+    XMemcopy_accel_InterruptEnable(&inst, 0x3);
+    CHECK(XMemcopy_accel_InterruptGetEnabled(&inst) == 0x3, "IER read back");
+
+    fill_src(1);
+    XMemcopy_accel_Set_src(&inst, (UINTPTR)src);
+    XMemcopy_accel_Set_dst(&inst, (UINTPTR)dst);
+    XMemcopy_accel_Set_len(&inst, len);
+    XMemcopy_accel_Set_src_off(&inst, 0);
+    XMemcopy_accel_Set_dst_off(&inst, 0);
+    XMemcopy_accel_Set_dst_bytes(&inst, (UINTPTR)dst);
+    XMemcopy_accel_Set_op(&inst, MEMCOPY_OP_COPY);
+    CHECK(XMemcopy_accel_Get_len(&inst) == len, "argument read back");
+    uint64_t starts = memcopy_model_starts(XPAR_MEMCOPY_ACCEL_1_BASEADDR);
+    XMemcopy_accel_Start(&inst);
+
+    CHECK(poll_done(&inst), "ap_done");
+    CHECK(!XMemcopy_accel_IsDone(&inst), "ap_done is clear on read");
+    CHECK(!memcopy_model_ctrl_chain() || !XMemcopy_accel_IsIdle(&inst), "ap_ctrl_chain holds the run until ap_continue");
+    CHECK(dst_is(0, src, len), "copied data");
+    CHECK(XMemcopy_accel_Get_crc_vld(&inst) == 1, "crc_ap_vld");
+    CHECK(XMemcopy_accel_Get_crc_vld(&inst) == 0, "crc_ap_vld is clear on read");
+    CHECK(XMemcopy_accel_Get_crc(&inst) == crc32_ref(src, len), "crc 0x%08x", XMemcopy_accel_Get_crc(&inst));
+    CHECK(XMemcopy_accel_InterruptGetStatus(&inst) == 0x3, "ISR ap_done | ap_ready");
+    XMemcopy_accel_InterruptClear(&inst, 0x1);
+    CHECK(XMemcopy_accel_InterruptGetStatus(&inst) == 0x2, "ISR toggle on write");
+    XMemcopy_accel_InterruptClear(&inst, 0x2);
+    CHECK(memcopy_model_starts(XPAR_MEMCOPY_ACCEL_1_BASEADDR) == starts + 1, "one start");
+
+    /* Not enabled in IER: the ISR bit stays clear */
+    XMemcopy_accel_Continue(&inst);
+    XMemcopy_accel_InterruptDisable(&inst, 0x3);
+    XMemcopy_accel_Start(&inst);
+    CHECK(poll_done(&inst), "second run");
+    CHECK(XMemcopy_accel_InterruptGetStatus(&inst) == 0, "ISR gated by IER");
+    XMemcopy_accel_Continue(&inst);
+
+    /* auto_restart reruns the latched job on every ap_continue; with
+       ap_ctrl_hs it reruns freely, which the count below cannot pin down */
+    if (!memcopy_model_ctrl_chain())
+        return;
+    starts = memcopy_model_starts(XPAR_MEMCOPY_ACCEL_1_BASEADDR);
+    XMemcopy_accel_EnableAutoRestart(&inst);
+    XMemcopy_accel_Start(&inst);
+    for (int i = 0; i < 3; ++i) {
+        CHECK(poll_done(&inst), "auto_restart run %d", i);
+        if (i == 2)
+            XMemcopy_accel_DisableAutoRestart(&inst);
+        XMemcopy_accel_Continue(&inst);
+    }
+    /* the start latched before auto_restart was dropped still runs */
+    CHECK(poll_done(&inst), "last auto_restart run");
+    XMemcopy_accel_Continue(&inst);
+    CHECK(memcopy_model_starts(XPAR_MEMCOPY_ACCEL_1_BASEADDR) == starts + 4, "auto_restart runs %u",
+          (unsigned)(memcopy_model_starts(XPAR_MEMCOPY_ACCEL_1_BASEADDR) - starts));
+}
+
+/* Byte-exact copies: every src/dst offset within a beat, lengths around
+   beat and burst boundaries, guard bytes around the destination */
+static void test_unaligned(void)
+{
+    static const uint32_t lens[] = { 0, 1, 7, 8, 9, 63, 64, 65, 1000, 4097 };
+
+    fill_src(2);
+    for (uint32_t s = 0; s < 8; ++s) {
+        for (uint32_t d = 0; d < 8; ++d) {
+            for (uint32_t k = 0; k < sizeof(lens) / sizeof(lens[0]); ++k) {
+                memset(dst, GUARD, sizeof(dst));
+                int rc = memcopy_ch_copy_polling(0, (UINTPTR)(src + s), (UINTPTR)(dst + 8 + d), lens[k]);
+                CHECK(rc == 0 && dst_is(8 + d, src + s, lens[k]), "src+%u dst+%u len %u", s, d, lens[k]);
+                CHECK(memcopy_ch_get_crc(0) == crc32_ref(src + s, lens[k]), "crc src+%u len %u", s, lens[k]);
+            }
+        }
+    }
+}
+
+static void test_fill_compare_2d(void)
+{
+    uint64_t first, count;
+
+    /* fill and incrementing pattern, 32-bit words */
+    memset(dst, GUARD, sizeof(dst));
+    memcopy_ch_start_fill(0, (UINTPTR)(dst + 8), 256, 0xA5A5A5A5u, false);
+    memcopy_ch_wait_done(0);
+    memset(ref, 0xA5, 256);
+    CHECK(dst_is(8, ref, 256), "fill");
+    memcopy_ch_start_fill(0, (UINTPTR)(dst + 8), 256, 100, true);
+    memcopy_ch_wait_done(0);
+    for (uint32_t i = 0; i < 64; ++i) {
+        uint32_t w = 100 + i;
+        memcpy(ref + 4 * i, &w, 4);
+    }
+    CHECK(dst_is(8, ref, 256), "pattern");
+
+    /* compare: equal, then three differing bytes */
+    fill_src(3);
+    memcpy(dst, src + 5, 3000);
+    memcopy_ch_start_compare(0, (UINTPTR)(src + 5), (UINTPTR)dst, 3000);
+    memcopy_ch_wait_done(0);
+    CHECK(memcopy_ch_get_compare(0, &first, &count) && count == 0, "compare equal");
+    dst[2999] ^= 1;
+    dst[700] ^= 1;
+    dst[1500] ^= 0xFF;
+    memcopy_ch_start_compare(0, (UINTPTR)(src + 5), (UINTPTR)dst, 3000);
+    memcopy_ch_wait_done(0);
+    CHECK(!memcopy_ch_get_compare(0, &first, &count) && first == 700 && count == 3,
+          "compare first %u count %u", (unsigned)first, (unsigned)count);
+
+    /* 2D: 13 rows of 37 bytes, pitch 100 -> 61 */
+    fill_src(4);
+    memset(dst, GUARD, sizeof(dst));
+    memcopy_ch_start_2d(0, (UINTPTR)(src + 3), (UINTPTR)(dst + 5), 13, 37, 100, 61);
+    memcopy_ch_wait_done(0);
+    int ok = 1;
+    for (uint32_t i = 0; i < sizeof(dst); ++i) {
+        uint32_t row = i >= 5 ? (i - 5) / 61 : 13, col = i >= 5 ? (i - 5) % 61 : 0;
+        uint8_t want = (row < 13 && col < 37) ? src[3 + row * 100 + col] : GUARD;
+        ok &= dst[i] == want;
+    }
+    CHECK(ok, "2d tile");
+}
+
+static void test_chain(void)
+{
+    static memcopy_desc_t desc[8] __attribute__((aligned(64)));
+    static const struct { uint32_t src, dst, len; } frags[] = {
+        { 0, 0, 64 }, { 100, 203, 333 }, { 7, 1024, 1 }, { 513, 1100, 999 }, { 60, 2200, 17 },
+    };
+    memcopy_chain_t chain;
+    memcopy_job_t job;
+
+    memcopy_job_init(&job, MEMCOPY_OP_SG, 0, 0, 0);
+    CHECK(memcopy_submit(0, &job) == MEMCOPY_TICKET_NONE, "SG job without a chain rejected");
+
+    fill_src(5);
+    memset(dst, GUARD, sizeof(dst));
+    memcpy(ref, dst, sizeof(dst));
+    memcopy_chain_init(&chain, desc, 8);
+    for (uint32_t i = 0; i < sizeof(frags) / sizeof(frags[0]); ++i) {
+        memcopy_chain_add(&chain, (UINTPTR)(src + frags[i].src), (UINTPTR)(dst + frags[i].dst), frags[i].len);
+        memcpy(ref + frags[i].dst, src + frags[i].src, frags[i].len);
+    }
+    memcopy_ch_chain_submit(0, &chain);
+    memcopy_ch_wait_done(0);
+    CHECK(memcmp(dst, ref, sizeof(dst)) == 0, "scatter-gather chain");
+}
+
+static void test_isr(void *ref_ch)
+{
+    memcopy_ch_irq((uint32_t)(UINTPTR)ref_ch);
+}
+
+static void setup_interrupts(void)
+{
+    static const u32 irq[] = { XPAR_FABRIC_MEMCOPY_ACCEL_0_INTR, XPAR_FABRIC_MEMCOPY_ACCEL_1_INTR };
+    XScuGic_Config *cfg = XScuGic_LookupConfig(XPAR_SCUGIC_SINGLE_DEVICE_ID);
+
+    XScuGic_CfgInitialize(&intc, cfg, cfg->CpuBaseAddress);
+    Xil_ExceptionInit();
+    Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT, (Xil_ExceptionHandler)XScuGic_InterruptHandler, &intc);
+    for (uint32_t ch = 0; ch < 2; ++ch) {
+        XScuGic_Connect(&intc, irq[ch], test_isr, (void *)(UINTPTR)ch);
+        XScuGic_Enable(&intc, irq[ch]);
+    }
+    Xil_ExceptionEnable();
+    for (uint32_t ch = 0; ch < 2; ++ch)
+        memcopy_ch_interrupt_enable(ch);
+}
+
+/* Queued jobs completed from the ISR on both channels */
+static void test_queue(void)
+{
+    enum { JOBS = 24, JOB_BYTES = 256 };
+    static memcopy_job_t job[JOBS];
+    memcopy_ticket_t ticket[JOBS];
+    memcopy_queue_stats_t st[2];
+    uint32_t in_ip = MEMCOPY_ACCEL_CTRL_CHAIN ? 2 : 1;    /* jobs the IP takes at once */
+
+    fill_src(6);
+    memset(dst, GUARD, sizeof(dst));
+    for (uint32_t ch = 0; ch < 2; ++ch)
+        memcopy_ch_reset_queue_stats(ch);
+    /* with the IRQ masked in_ip jobs per channel go into the IP and the
+       rest wait in the queue, so they can only be started from the ISR */
+    Xil_ExceptionDisable();
+    for (uint32_t i = 0; i < JOBS; ++i) {
+        memcopy_job_init(&job[i], MEMCOPY_OP_COPY, (UINTPTR)(src + i * JOB_BYTES + 1),
+                         (UINTPTR)(dst + i * JOB_BYTES), JOB_BYTES);
+        ticket[i] = memcopy_submit(i & 1u, &job[i]);
+        CHECK(ticket[i] != MEMCOPY_TICKET_NONE, "submit %u", i);
+    }
+    Xil_ExceptionEnable();
+    for (uint32_t i = 0; i < JOBS; ++i) {
+        CHECK(memcopy_wait(ticket[i], TIMEOUT_US) == 0, "wait %u", i);
+        CHECK(job[i].crc == crc32_ref(src + i * JOB_BYTES + 1, JOB_BYTES), "job %u crc", i);
+    }
+    CHECK(dst_is(0, src + 1, JOBS * JOB_BYTES), "queued copies");
+    for (uint32_t ch = 0; ch < 2; ++ch) {
+        memcopy_ch_get_queue_stats(ch, &st[ch]);
+        CHECK(st[ch].completed == JOBS / 2 && st[ch].depth == 0, "ch%u completed %u", ch, st[ch].completed);
+        CHECK(st[ch].started_direct == in_ip && st[ch].started_chained == JOBS / 2 - in_ip,
+              "ch%u started %u direct, %u from the ISR", ch, st[ch].started_direct, st[ch].started_chained);
+    }
+}
+
+static void test_chunked(void)
+{
+    fill_src(7);
+    memset(dst, GUARD, sizeof(dst));
+    CHECK(memcopy_ch_copy_chunked(0, dst + 3, src + 9, 7000, 1024) == 0 && dst_is(3, src + 9, 7000),
+          "chunked copy");
+}
+
+/* Lets the channel 0 ISR run again half a chunk timeout after the first
+   chunk below timed out */
+static void *late_irq(void *arg)
+{
+    uint64_t ns = (uint64_t)MEMCOPY_CHUNK_TIMEOUT_US * 1500u;
+    struct timespec ts = { (time_t)(ns / 1000000000u), (long)(ns % 1000000000u) };
+
+    (void)arg;
+    nanosleep(&ts, NULL);
+    XScuGic_Enable(&intc, XPAR_FABRIC_MEMCOPY_ACCEL_0_INTR);
+    return NULL;
+}
+
+/* A chunked copy that times out returns only once every chunk it queued
+   has finished: the ISR writes their results afterwards otherwise */
+static void test_chunked_timeout(void)
+{
+    enum { FILL = MEMCOPY_JOB_QUEUE_DEPTH - 2, JOB_BYTES = 64 };
+    static memcopy_job_t job[FILL];
+    memcopy_queue_stats_t st;
+    pthread_t thread;
+
+    fill_src(9);
+    memset(dst, GUARD, sizeof(dst));
+    memset(ref, 0, sizeof(ref));
+    /* with the ISR held off the fillers and chunks 0 and 1 stay queued */
+    XScuGic_Disable(&intc, XPAR_FABRIC_MEMCOPY_ACCEL_0_INTR);
+    for (uint32_t i = 0; i < FILL; ++i) {
+        memcopy_job_init(&job[i], MEMCOPY_OP_COPY, (UINTPTR)(src + i * JOB_BYTES),
+                         (UINTPTR)(ref + i * JOB_BYTES), JOB_BYTES);
+        CHECK(memcopy_submit(0, &job[i]) != MEMCOPY_TICKET_NONE, "filler %u", i);
+    }
+    CHECK(pthread_create(&thread, NULL, late_irq, NULL) == 0, "late_irq thread");
+    CHECK(memcopy_ch_copy_chunked(0, dst, src, 4096, 1024) == -1, "chunked copy timed out");
+    memcopy_ch_get_queue_stats(0, &st);
+    CHECK(st.depth == 0, "chunked copy returned with %u jobs queued", st.depth);
+    pthread_join(thread, NULL);
+    CHECK(memcmp(ref, src, FILL * JOB_BYTES) == 0 && dst_is(0, src, 2048), "copies before the timeout");
+
+    memset(dst, GUARD, sizeof(dst));
+    CHECK(memcopy_ch_copy_chunked(0, dst, src, 4096, 1024) == 0 && dst_is(0, src, 4096),
+          "chunked copy after a timeout");
+}
+
+/* Commands through the DDR ring, one doorbell */
+static void test_ring(void)
+{
+    enum { SLOTS = 16, JOBS = 12, JOB_BYTES = 256 };
+    static memcopy_ring_t ring;
+    static memcopy_desc_t cmd[SLOTS] __attribute__((aligned(64)));
+    static memcopy_cpl_t cpl[SLOTS + 1] __attribute__((aligned(64)));
+    memcopy_cpl_t c;
+    uint32_t reaped = 0;
+    int stopped = 0;
+    XTime t0, now;
+
+    fill_src(8);
+    memset(dst, GUARD, sizeof(dst));
+    CHECK(memcopy_ring_start(&ring, 0, cmd, cpl, SLOTS, 4, 256) == 0, "ring start");
+    for (uint32_t i = 0; i < JOBS; ++i)
+        memcopy_ring_add(&ring, (UINTPTR)(src + i * JOB_BYTES), (UINTPTR)(dst + i * JOB_BYTES), JOB_BYTES, i);
+    memcopy_ring_doorbell(&ring);
+
+    XTime_GetTime(&t0);
+    while (!stopped) {
+        while (memcopy_ring_reap(&ring, &c)) {
+            if (c.status & MEMCOPY_CPL_STOP) {
+                stopped = 1;
+                break;
+            }
+            CHECK(c.cookie == reaped && c.len == JOB_BYTES, "completion %u", reaped);
+            if (++reaped == JOBS)
+                memcopy_ring_stop(&ring);
+        }
+        XTime_GetTime(&now);
+        if (now - t0 > (XTime)TIMEOUT_US * (COUNTS_PER_SECOND / 1000000))
+            break;
+    }
+    CHECK(stopped && reaped == JOBS, "ring reaped %u of %u", reaped, (unsigned)JOBS);
+    CHECK(dst_is(0, src, JOBS * JOB_BYTES), "ring copies");
+
+    /* The stop completion comes once the channel is idle: a job submitted
+       right after it must not take the ring's last ap_done as its own */
+    memcopy_job_t job;
+    memcopy_job_init(&job, MEMCOPY_OP_CMP, (UINTPTR)src, (UINTPTR)dst, JOBS * JOB_BYTES);
+    CHECK(memcopy_wait(memcopy_submit(0, &job), TIMEOUT_US) == 0, "job after the ring");
+    CHECK(job.cmp_match && job.cmp_count == 0, "job after the ring: compare result");
+}
+
+int main(void)
+{
+    memcopy_ch_init(0, XPAR_MEMCOPY_ACCEL_0_BASEADDR);
+    memcopy_ch_init(1, XPAR_MEMCOPY_ACCEL_1_BASEADDR);
+
+    test_registers();
+    test_unaligned();
+    test_fill_compare_2d();
+    test_chain();
+    setup_interrupts();
+    test_queue();
+    test_chunked();
+    test_chunked_timeout();
+    test_ring();
+
+    printf("%d checks, %d failed\n", checks, failures);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
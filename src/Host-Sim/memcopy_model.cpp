@@ -0,0 +1,256 @@
+// Functional model of the memcopy_accel CTRL_BUS register file, see
+// memcopy_model.h. Built with the same MEMCOPY_* options as the IP.
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include "memcopy_accel.h"
+#include "xmemcopy_accel_hw.h"
+#include "memcopy_model.h"
+
+#define REG(name)   XMEMCOPY_ACCEL_CTRL_BUS_ADDR_##name
+
+// The masters address host memory directly: a beat must overlay exactly
+// BUS_WIDTH / 8 bytes of it, as the m_axi adapter does in DDR
+static_assert(sizeof(memcopy_beat_t) == MEMCOPY_BUS_WIDTH / 8, "memcopy_beat_t must be BUS_WIDTH bits");
+
+namespace {
+
+const uint32_t AP_START     = 0x001;
+const uint32_t AP_DONE      = 0x002;
+const uint32_t AP_IDLE      = 0x004;
+const uint32_t AP_READY     = 0x008;
+const uint32_t AP_CONTINUE  = 0x010;
+const uint32_t AUTO_RESTART = 0x080;
+const uint32_t AP_INTERRUPT = 0x200;
+const uint32_t NUM_REGS     = MEMCOPY_MODEL_NUM_REGS;
+
+// _ap_vld registers of the outputs (Read/COR)
+const uint32_t vld_regs[] = {
+    REG(CRC_CTRL), REG(CMP_MATCH_CTRL), REG(CMP_FIRST_CTRL), REG(CMP_COUNT_CTRL),
+    REG(PERF_CYCLES_CTRL), REG(PERF_RD_BEATS_CTRL), REG(PERF_WR_BEATS_CTRL), REG(PERF_STALL_CTRL),
+};
+
+bool is_vld_reg(uint32_t off) {
+    for (uint32_t r : vld_regs)
+        if (r == off) return true;
+    return false;
+}
+
+bool is_output_reg(uint32_t off) {
+    return (off >= REG(CRC_DATA) && off < REG(CPL_DATA)) || is_vld_reg(off);
+}
+
+void (*irq_hook)(uint32_t irq_id);
+
+struct engine {
+    uintptr_t base = 0;
+    uint32_t irq_id = 0;
+    std::mutex m;
+    std::condition_variable cv;
+    uint32_t regs[NUM_REGS] = {};
+    bool start = false, done = false, ready = false, idle = true;
+    bool auto_restart = false, held = false;
+    uint32_t gie = 0, ier = 0, isr = 0;
+    uint64_t starts = 0;
+
+    void raise(uint32_t bits) {
+        isr |= bits;
+        if (gie && irq_hook) irq_hook(irq_id);
+    }
+
+    void run();
+};
+
+engine* engines[MEMCOPY_MODEL_MAX_ENGINES];
+int num_engines;
+
+uint64_t arg64(const uint32_t* r, uint32_t off) {
+    return r[off / 4] | (uint64_t)r[off / 4 + 1] << 32;
+}
+
+void output32(uint32_t* r, uint32_t off, uint32_t v) {
+    r[off / 4] = v;
+    r[off / 4 + 1] = 1;
+}
+
+void output64(uint32_t* r, uint32_t off, uint64_t v) {
+    r[off / 4] = (uint32_t)v;
+    r[off / 4 + 1] = (uint32_t)(v >> 32);
+    r[off / 4 + 2] = 1;
+}
+
+engine* find(uintptr_t addr) {
+    for (int i = 0; i < num_engines; ++i) {
+        if (addr - engines[i]->base < MEMCOPY_MODEL_SPAN) return engines[i];
+    }
+    return nullptr;
+}
+
+template <typename T> T* axi(uint64_t addr) { return reinterpret_cast<T*>((uintptr_t)addr); }
+
+// The IP: wait for ap_start, latch the arguments, run the top function,
+// post the outputs and ap_done, and under ap_ctrl_chain hold ap_done until
+// ap_continue before taking the next start.
+void engine::run() {
+    std::unique_lock<std::mutex> lock(m);
+    for (;;) {
+        cv.wait(lock, [this] { return start; });
+
+        uint32_t r[NUM_REGS];
+        memcpy(r, regs, sizeof(r));
+        start = auto_restart;
+        idle = false;
+        ready = true;
+        if (ier & 0x2) raise(0x2);
+        starts++;
+        lock.unlock();
+
+        memcopy_model_execute(r);
+
+        lock.lock();
+        for (uint32_t off = REG(CRC_DATA); off < REG(CPL_DATA); off += 4) {
+            bool cmp = off >= REG(CMP_MATCH_DATA) && off < REG(PERF_CYCLES_DATA);
+            if (!cmp || r[REG(OP_DATA) / 4] == MEMCOPY_OP_CMP) regs[off / 4] = r[off / 4];
+        }
+        done = true;
+        if (ier & 0x1) raise(0x1);
+#if MEMCOPY_CTRL_CHAIN
+        held = true;
+        cv.wait(lock, [this] { return !held; });
+#endif
+        idle = true;
+    }
+}
+
+} // namespace
+
+void memcopy_model_execute(uint32_t* r) {
+    uint32_t crc = 0, cmp_match = 0;
+    uint64_t cmp_first = 0, cmp_count = 0;
+    uint32_t cycles = 0, rd_beats = 0, wr_beats = 0, stall = 0;
+    uint32_t op = r[REG(OP_DATA) / 4];
+    memcopy_accel(axi<memcopy_beat_t>(arg64(r, REG(SRC_DATA))),
+                  axi<memcopy_beat_t>(arg64(r, REG(DST_DATA))),
+                  arg64(r, REG(LEN_DATA)),
+                  r[REG(SRC_OFF_DATA) / 4], r[REG(DST_OFF_DATA) / 4],
+                  axi<uint8_t>(arg64(r, REG(DST_BYTES_DATA))),
+                  op,
+                  axi<memcopy_beat_t>(arg64(r, REG(DESC_DATA))),
+                  r[REG(ROWS_DATA) / 4], r[REG(ROW_BYTES_DATA) / 4],
+                  r[REG(SRC_STRIDE_DATA) / 4], r[REG(DST_STRIDE_DATA) / 4],
+                  r[REG(FILL_DATA) / 4], &crc,
+                  &cmp_match, &cmp_first, &cmp_count,
+                  &cycles, &rd_beats, &wr_beats, &stall,
+                  axi<memcopy_beat_t>(arg64(r, REG(CPL_DATA))),
+                  axi<volatile uint32_t>(arg64(r, REG(RING_PROD_DATA))),
+                  r[REG(IRQ_COUNT_DATA) / 4], r[REG(IRQ_IDLE_DATA) / 4]);
+
+    output32(r, REG(CRC_DATA), crc);
+    if (op == MEMCOPY_OP_CMP) {
+        output32(r, REG(CMP_MATCH_DATA), cmp_match);
+        output64(r, REG(CMP_FIRST_DATA), cmp_first);
+        output64(r, REG(CMP_COUNT_DATA), cmp_count);
+    }
+    output32(r, REG(PERF_CYCLES_DATA), cycles);
+    output32(r, REG(PERF_RD_BEATS_DATA), rd_beats);
+    output32(r, REG(PERF_WR_BEATS_DATA), wr_beats);
+    output32(r, REG(PERF_STALL_DATA), stall);
+}
+
+bool memcopy_model_ctrl_chain(void) {
+    return MEMCOPY_CTRL_CHAIN != 0;
+}
+
+int memcopy_model_attach(uintptr_t base, uint32_t irq_id) {
+    if (num_engines == MEMCOPY_MODEL_MAX_ENGINES || find(base)) return -1;
+
+    // Never freed: the worker may still be inside a kernel at exit
+    engine* e = new engine;
+    e->base = base;
+    e->irq_id = irq_id;
+    engines[num_engines] = e;
+    std::thread(&engine::run, e).detach();
+    return num_engines++;
+}
+
+bool memcopy_model_claims(uintptr_t addr) {
+    return find(addr) != nullptr;
+}
+
+uint32_t memcopy_model_read(uintptr_t addr) {
+    engine* e = find(addr);
+    uint32_t off = (uint32_t)(addr - e->base) & ~3u;
+    uint32_t v;
+
+    std::lock_guard<std::mutex> lock(e->m);
+    switch (off) {
+    case REG(AP_CTRL):
+        v = (e->start ? AP_START : 0) | (e->done ? AP_DONE : 0) | (e->idle && !e->start ? AP_IDLE : 0) |
+            (e->ready ? AP_READY : 0) | (e->auto_restart ? AUTO_RESTART : 0) |
+            (e->gie && e->isr ? AP_INTERRUPT : 0);
+        e->done = false;
+        e->ready = false;
+        return v;
+    case REG(GIE):
+        return e->gie;
+    case REG(IER):
+        return e->ier;
+    case REG(ISR):
+        return e->isr;
+    default:
+        if (off >= NUM_REGS * 4) return 0;
+        v = e->regs[off / 4];
+        if (is_vld_reg(off)) e->regs[off / 4] = 0;
+        return v;
+    }
+}
+
+void memcopy_model_write(uintptr_t addr, uint32_t value) {
+    engine* e = find(addr);
+    uint32_t off = (uint32_t)(addr - e->base) & ~3u;
+
+    std::lock_guard<std::mutex> lock(e->m);
+    switch (off) {
+    case REG(AP_CTRL):
+        e->auto_restart = (value & AUTO_RESTART) != 0;
+        if (value & AP_START) e->start = true;
+        // a continue pulse only counts while ap_done is held
+        if ((value & AP_CONTINUE) && e->held) e->held = false;
+        e->cv.notify_all();
+        break;
+    case REG(GIE):
+        e->gie = value & 0x1;
+        break;
+    case REG(IER):
+        e->ier = value & 0x3;
+        break;
+    case REG(ISR):
+        e->isr ^= value & 0x3;
+        break;
+    default:
+        if (off < NUM_REGS * 4 && !is_output_reg(off)) e->regs[off / 4] = value;
+        break;
+    }
+}
+
+bool memcopy_model_irq(uint32_t irq_id) {
+    for (int i = 0; i < num_engines; ++i) {
+        engine* e = engines[i];
+        if (e->irq_id != irq_id) continue;
+        std::lock_guard<std::mutex> lock(e->m);
+        if (e->gie && e->isr) return true;
+    }
+    return false;
+}
+
+uint64_t memcopy_model_starts(uintptr_t base) {
+    engine* e = find(base);
+    if (!e) return 0;
+    std::lock_guard<std::mutex> lock(e->m);
+    return e->starts;
+}
+
+void memcopy_model_set_irq_hook(void (*hook)(uint32_t irq_id)) {
+    irq_hook = hook;
+}
@@ -0,0 +1,66 @@
+/* Functional model of the memcopy_accel CTRL_BUS register file.
+ *
+ * Each attached engine has a worker thread that plays the IP: ap_start
+ * latches the argument registers and runs the HLS top function
+ * (src/Vitis-HLS/memcopy_accel.cpp) on them, with the AXI masters reading
+ * and writing host memory at the programmed addresses. Control follows
+ * the generated xmemcopy_accel_hw.h:
+ *   AP_CTRL  ap_start (COH, kept by auto_restart), ap_done and ap_ready
+ *            (COR), ap_idle (only while ap_start is low), ap_continue
+ *            (SC, releases ap_done under ap_ctrl_chain), auto_restart,
+ *            interrupt. The top is a DATAFLOW region, so ap_ready comes
+ *            as the arguments are latched and re-arms ap_start from
+ *            auto_restart there, at the start of the run.
+ *   GIE/IER  read/write, ISR toggle-on-write, a bit only set if enabled
+ *   outputs  crc, cmp_*, perf_* with their _ap_vld bits (COR)
+ * The interrupt line is GIE && ISR != 0, sampled by the host BSP.
+ */
+#ifndef MEMCOPY_MODEL_H
+#define MEMCOPY_MODEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMCOPY_MODEL_MAX_ENGINES   4
+#define MEMCOPY_MODEL_SPAN          0x10000u    /* CTRL_BUS address window */
+#define MEMCOPY_MODEL_NUM_REGS      (0x100 / 4) /* words of the register map */
+
+/* Run the IP once on the arguments in regs, an image of the register map
+   (MEMCOPY_MODEL_NUM_REGS words at the xmemcopy_accel_hw.h offsets), and
+   store the outputs with their _ap_vld bits back into it. The cmp_*
+   outputs are only written by MEMCOPY_OP_CMP. The AXI masters address
+   host memory. */
+void memcopy_model_execute(uint32_t *regs);
+
+/* True if the kernel was built with ap_ctrl_chain (MEMCOPY_CTRL_CHAIN):
+   ap_done is then held until ap_continue */
+bool memcopy_model_ctrl_chain(void);
+
+/* Add an engine at base with interrupt irq_id. Returns its index or -1. */
+int memcopy_model_attach(uintptr_t base, uint32_t irq_id);
+
+/* True if addr is inside an attached engine's window */
+bool memcopy_model_claims(uintptr_t addr);
+
+uint32_t memcopy_model_read(uintptr_t addr);
+void memcopy_model_write(uintptr_t addr, uint32_t value);
+
+/* Level of the interrupt line irq_id (any engine wired to it) */
+bool memcopy_model_irq(uint32_t irq_id);
+
+/* Jobs the engine at base has accepted (ap_start handshakes) */
+uint64_t memcopy_model_starts(uintptr_t base);
+
+/* Called from a worker thread whenever it sets an ISR bit with GIE on,
+   with the engine locked: it may only signal the CPU thread */
+void memcopy_model_set_irq_hook(void (*hook)(uint32_t irq_id));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,380 @@
+/* Linux UIO driver (xmemcopy_accel_linux.c, the __linux__ branch of the
+ * generated driver) on a fake UIO tree (fake_uio.c) served by the kernel
+ * model. Checks device discovery, the mmaps and copies, then times
+ *   init     XMemcopy_accel_InitializeAll() + Release() of every engine
+ *   mmap     XMemcopy_accel_PoolOpenUio() + PoolClose() of map1
+ *   copy     threads doing ClaimAny/StartCopy/Complete, polling ap_done
+ *            or sleeping in poll() on the ap_done interrupt, which the
+ *            harness delivers as a UIO device would (fake_uio.h)
+ * Each timed loop runs for UIO_BENCH_MS milliseconds (default 200). The
+ * copy rates are those of the C model of the kernel and only compare
+ * driver paths with each other. Prints one line per failed check, the
+ * results and a summary; exit status 0 = pass.
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "xmemcopy_accel.h"
+#include "fake_uio.h"
+
+#define UIO_NAME        "memcopy_accel"
+#define MAX_ENGINES     8
+#define MAX_THREADS     4
+#define DMA_BYTES       (2u << 20)
+#define SLAB_BYTES      (128u << 10)
+#define GUARD           0x5A
+#define TIMEOUT_MS      1000
+#define WATCHDOG_S      120
+
+/* The tree: a decoy device, and the engines out of alphasort order */
+static const int engine_nums[] = { 1, 2, 10 };
+#define NUM_ENGINES     (int)(sizeof(engine_nums) / sizeof(engine_nums[0]))
+
+static fake_uio *tree;
+static int bench_ms = 200;
+static int checks, failures;
+
+#define CHECK(cond, ...)                                            \
+    do {                                                            \
+        __atomic_fetch_add(&checks, 1, __ATOMIC_RELAXED);           \
+        if (!(cond)) {                                              \
+            __atomic_fetch_add(&failures, 1, __ATOMIC_RELAXED);     \
+            printf("FAIL %s:%d: ", __func__, __LINE__);             \
+            printf(__VA_ARGS__);                                    \
+            printf("\n");                                           \
+        }                                                           \
+    } while (0)
+
+static double now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/* zlib crc32() */
+static uint32_t crc32_ref(const uint8_t *p, size_t len)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+
+    while (len--) {
+        crc ^= *p++;
+        for (int b = 0; b < 8; ++b)
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1u));
+    }
+    return ~crc;
+}
+
+/* ap_idle follows ap_continue a little later, as on the IP */
+static int wait_idle(XMemcopy_accel *inst)
+{
+    double t0 = now_us();
+
+    while (!XMemcopy_accel_IsIdle(inst)) {
+        if (now_us() - t0 > TIMEOUT_MS * 1000.0)
+            return 0;
+        sched_yield();
+    }
+    return 1;
+}
+
+static void irq_enable(XMemcopy_accel *eng, int n, int on)
+{
+    for (int i = 0; i < n; ++i) {
+        if (on) {
+            XMemcopy_accel_InterruptGlobalEnable(&eng[i]);
+            XMemcopy_accel_InterruptEnable(&eng[i], 0x1);
+        } else {
+            XMemcopy_accel_InterruptDisable(&eng[i], 0x1);
+            XMemcopy_accel_InterruptGlobalDisable(&eng[i]);
+        }
+    }
+}
+
+static void test_init(void)
+{
+    XMemcopy_accel eng[MAX_ENGINES], one;
+    double t0, t;
+    int n, loops = 0;
+
+    n = XMemcopy_accel_InitializeAll(eng, MAX_ENGINES, UIO_NAME);
+    CHECK(n == NUM_ENGINES, "InitializeAll found %d engines", n);
+    for (int i = 0; i < n; ++i) {
+        CHECK(XMemcopy_accel_IsIdle(&eng[i]), "engine %d not idle after init", i);
+        XMemcopy_accel_Release(&eng[i]);
+    }
+    /* alphasort lists uio10 before uio2; the lowest two are still 1 and 2 */
+    CHECK(XMemcopy_accel_InitializeAll(eng, 2, UIO_NAME) == 2, "InitializeAll ignores MaxInstances");
+    CHECK(fake_uio_fd_num(XMemcopy_accel_GetIrqFd(&eng[0])) == engine_nums[0] &&
+          fake_uio_fd_num(XMemcopy_accel_GetIrqFd(&eng[1])) == engine_nums[1],
+          "InitializeAll(2) opened uio%d, uio%d", fake_uio_fd_num(XMemcopy_accel_GetIrqFd(&eng[0])),
+          fake_uio_fd_num(XMemcopy_accel_GetIrqFd(&eng[1])));
+    XMemcopy_accel_Release(&eng[0]);
+    XMemcopy_accel_Release(&eng[1]);
+    CHECK(XMemcopy_accel_Initialize(&one, UIO_NAME) == XST_SUCCESS &&
+          fake_uio_fd_num(XMemcopy_accel_GetIrqFd(&one)) == engine_nums[0], "Initialize did not open the lowest uioN");
+    XMemcopy_accel_Release(&one);
+    CHECK(XMemcopy_accel_Initialize(&one, "no_such_ip") == XST_DEVICE_NOT_FOUND, "unknown name found");
+
+    t0 = now_us();
+    do {
+        n = XMemcopy_accel_InitializeAll(eng, MAX_ENGINES, UIO_NAME);
+        for (int i = 0; i < n; ++i)
+            XMemcopy_accel_Release(&eng[i]);
+        loops++;
+        t = now_us() - t0;
+    } while (t < bench_ms * 1000.0);
+    printf("init   %d engines: %8.1f us per InitializeAll + Release\n", NUM_ENGINES, t / loops);
+}
+
+static void test_pool(XMemcopy_accel *inst)
+{
+    XMemcopy_accel_Pool pool;
+    double t0, t;
+    int loops = 0;
+
+    CHECK(XMemcopy_accel_PoolOpenUio(&pool, inst, 2, SLAB_BYTES) == XST_DEVICE_NOT_FOUND, "map2 opened");
+    CHECK(XMemcopy_accel_PoolOpenUio(&pool, inst, 1, SLAB_BYTES) == XST_SUCCESS, "map1 not opened");
+    CHECK(pool.SlabCount == DMA_BYTES / SLAB_BYTES, "%u slabs", pool.SlabCount);
+    XMemcopy_accel_PoolClose(&pool);
+
+    t0 = now_us();
+    do {
+        XMemcopy_accel_PoolOpenUio(&pool, inst, 1, SLAB_BYTES);
+        XMemcopy_accel_PoolClose(&pool);
+        loops++;
+        t = now_us() - t0;
+    } while (t < bench_ms * 1000.0);
+    printf("mmap   %u KiB map1: %8.1f us per PoolOpenUio + PoolClose\n", DMA_BYTES >> 10, t / loops);
+}
+
+static uint32_t irqs_total(void)
+{
+    uint32_t n = 0;
+
+    for (int i = 0; i < NUM_ENGINES; ++i)
+        n += fake_uio_irqs(tree, engine_nums[i]);
+    return n;
+}
+
+/* Each engine in turn, unaligned, checked against the source, the guard
+   bytes, the crc output and the job count of the uioN it should be. With
+   irq set each engine must have taken interrupts, and none without. */
+static void test_copy(XMemcopy_accel *eng, int n, XMemcopy_accel_Pool *pool, int irq)
+{
+    static const uint32_t lens[] = { 1, 7, 64, 4097, 65536 + 3 };
+    XMemcopy_accel_Buf src, dst;
+    uint8_t *s, *d;
+
+    XMemcopy_accel_PoolAlloc(pool, &src);
+    XMemcopy_accel_PoolAlloc(pool, &dst);
+    s = src.Virt;
+    d = dst.Virt;
+    irq_enable(eng, n, irq);
+    for (int i = 0; i < n; ++i) {
+        uint32_t irqs = fake_uio_irqs(tree, engine_nums[i]);
+
+        for (uint32_t k = 0; k < sizeof(lens) / sizeof(lens[0]); ++k) {
+            uint32_t len = lens[k], so = (k * 3) % 8, doff = (k * 5 + i) % 8;
+            uint64_t jobs = fake_uio_jobs(tree, engine_nums[i]);
+            int ret;
+
+            for (uint32_t b = 0; b < len + 16; ++b)
+                s[b] = (uint8_t)(b * 131u + k + i);
+            memset(d, GUARD, len + 16);
+            XMemcopy_accel_PoolSyncForDevice(pool, &src, 0, len + 16);
+            XMemcopy_accel_PoolSyncForDevice(pool, &dst, 0, len + 16);
+
+            CHECK(XMemcopy_accel_TryClaim(&eng[i]) == XST_SUCCESS, "engine %d busy", i);
+            XMemcopy_accel_StartCopy(&eng[i], src.Phys + so, dst.Phys + doff, len);
+            ret = XMemcopy_accel_Complete(&eng[i], TIMEOUT_MS);
+            CHECK(ret == XST_SUCCESS, "engine %d len %u: Complete %d", i, len, ret);
+            if (ret != XST_SUCCESS)
+                return;
+            XMemcopy_accel_PoolSyncForCpu(pool, &dst, 0, len + 16);
+
+            CHECK(memcmp(d + doff, s + so, len) == 0, "engine %d len %u: data", i, len);
+            CHECK(doff == 0 || d[doff - 1] == GUARD, "engine %d len %u: head guard", i, len);
+            CHECK(d[doff + len] == GUARD, "engine %d len %u: tail guard", i, len);
+            CHECK(XMemcopy_accel_Get_crc(&eng[i]) == crc32_ref(s + so, len), "engine %d len %u: crc", i, len);
+            CHECK(fake_uio_jobs(tree, engine_nums[i]) == jobs + 1, "engine %d is not uio%d", i, engine_nums[i]);
+            CHECK(wait_idle(&eng[i]), "engine %d len %u: not idle", i, len);
+        }
+        irqs = fake_uio_irqs(tree, engine_nums[i]) - irqs;
+        CHECK(irq ? irqs > 0 : irqs == 0, "engine %d: %u interrupts", i, irqs);
+    }
+    irq_enable(eng, n, 0);
+    XMemcopy_accel_PoolFree(pool, &src);
+    XMemcopy_accel_PoolFree(pool, &dst);
+}
+
+/* Complete() on an engine that was never started gives up after
+   TimeoutMs, polling with IER alone (GIE clear routes no interrupt) and
+   asleep in poll() with both */
+static void test_timeout(XMemcopy_accel *inst)
+{
+    double t0, t;
+    int ret;
+
+    CHECK(XMemcopy_accel_TryClaim(inst) == XST_SUCCESS, "engine busy");
+    XMemcopy_accel_InterruptEnable(inst, 0x1);
+    for (int irq = 0; irq < 2; ++irq) {
+        if (irq)
+            XMemcopy_accel_InterruptGlobalEnable(inst);
+        t0 = now_us();
+        ret = XMemcopy_accel_Complete(inst, 50);
+        t = now_us() - t0;
+        CHECK(ret == XST_TIMEOUT && t >= 50e3 && t < TIMEOUT_MS * 1000.0, "%s: Complete %d after %.0f us",
+              irq ? "irq" : "poll", ret, t);
+    }
+    irq_enable(inst, 1, 0);
+    XMemcopy_accel_Unclaim(inst);
+}
+
+struct worker {
+    XMemcopy_accel *eng;
+    int n;
+    XMemcopy_accel_Buf src, dst;
+    uint32_t len;
+    double deadline;
+    pthread_barrier_t *go;
+    uint64_t jobs;
+};
+
+static void *copy_worker(void *arg)
+{
+    struct worker *w = arg;
+    uint8_t *s = w->src.Virt;
+
+    for (uint32_t b = 0; b < w->len; ++b)
+        s[b] = (uint8_t)(b ^ (uintptr_t)w);
+    pthread_barrier_wait(w->go);
+
+    while (now_us() < w->deadline) {
+        int i, ret;
+
+        while ((i = XMemcopy_accel_ClaimAny(w->eng, w->n)) < 0)
+            sched_yield();
+        XMemcopy_accel_StartCopy(&w->eng[i], w->src.Phys, w->dst.Phys, w->len);
+        ret = XMemcopy_accel_Complete(&w->eng[i], TIMEOUT_MS);
+        CHECK(ret == XST_SUCCESS, "engine %d: Complete %d", i, ret);
+        if (ret != XST_SUCCESS)
+            break;
+        w->jobs++;
+    }
+    CHECK(memcmp(w->dst.Virt, s, w->len) == 0, "len %u: data", w->len);
+    return NULL;
+}
+
+static void bench_copy(XMemcopy_accel *eng, int n, XMemcopy_accel_Pool *pool, int threads, uint32_t len, int irq)
+{
+    struct worker w[MAX_THREADS];
+    pthread_t tid[MAX_THREADS];
+    pthread_barrier_t go;
+    uint64_t jobs = 0;
+    uint32_t irqs = irqs_total();
+    double t0;
+
+    irq_enable(eng, n, irq);
+    pthread_barrier_init(&go, NULL, threads + 1);
+    for (int t = 0; t < threads; ++t) {
+        memset(&w[t], 0, sizeof(w[t]));
+        w[t].eng = eng;
+        w[t].n = n;
+        w[t].len = len;
+        w[t].go = &go;
+        w[t].deadline = 1e300;
+        XMemcopy_accel_PoolAlloc(pool, &w[t].src);
+        XMemcopy_accel_PoolAlloc(pool, &w[t].dst);
+    }
+    for (int t = 0; t < threads; ++t)
+        pthread_create(&tid[t], NULL, copy_worker, &w[t]);
+    t0 = now_us();
+    for (int t = 0; t < threads; ++t)
+        w[t].deadline = t0 + bench_ms * 1000.0;
+    pthread_barrier_wait(&go);
+    for (int t = 0; t < threads; ++t) {
+        pthread_join(tid[t], NULL);
+        jobs += w[t].jobs;
+        XMemcopy_accel_PoolFree(pool, &w[t].src);
+        XMemcopy_accel_PoolFree(pool, &w[t].dst);
+    }
+    t0 = now_us() - t0;
+    pthread_barrier_destroy(&go);
+    irq_enable(eng, n, 0);
+    irqs = irqs_total() - irqs;
+    CHECK(irq ? irqs > 0 : irqs == 0, "%s: %u interrupts", irq ? "irq" : "poll", irqs);
+
+    printf("copy   %d thread%s %6u B %-4s %10.0f jobs/s %9.2f MB/s %6.2f irq/job\n", threads, threads > 1 ? "s" : " ",
+           len, irq ? "irq" : "poll", jobs / (t0 / 1e6), jobs * (double)len / t0, jobs ? irqs / (double)jobs : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t sizes[] = { 256, 4096, 65536 };
+    XMemcopy_accel eng[MAX_ENGINES];
+    XMemcopy_accel_Pool pool;
+    const char *ms = getenv("UIO_BENCH_MS");
+    int n;
+
+    (void)argc;
+    (void)argv;
+    if (ms && atoi(ms) > 0)
+        bench_ms = atoi(ms);
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    alarm(WATCHDOG_S);  /* a hang in the driver or the model */
+
+    tree = fake_uio_create();
+    if (!tree) {
+        perror("fake_uio_create");
+        return EXIT_FAILURE;
+    }
+    if (fake_uio_add(tree, 0, "axi-gpio", 0, 0) < 0) {
+        perror("fake_uio_add");
+        fake_uio_destroy(tree);
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < NUM_ENGINES; ++i) {
+        if (fake_uio_add(tree, engine_nums[i], UIO_NAME, DMA_BYTES, 1) < 0) {
+            perror("fake_uio_add");
+            fake_uio_destroy(tree);
+            return EXIT_FAILURE;
+        }
+    }
+    CHECK(XMemcopy_accel_SetUioPaths(fake_uio_sysfs(tree), fake_uio_dev(tree)) == XST_SUCCESS, "SetUioPaths");
+
+    printf("fake UIO tree %s, %ld CPUs, %d ms per timed loop\n", fake_uio_dev(tree),
+           sysconf(_SC_NPROCESSORS_ONLN), bench_ms);
+    test_init();
+    n = XMemcopy_accel_InitializeAll(eng, MAX_ENGINES, UIO_NAME);
+    if (n != NUM_ENGINES) {
+        printf("FAIL %s: %d engines\n", __func__, n);
+        fake_uio_destroy(tree);
+        return EXIT_FAILURE;
+    }
+    test_pool(&eng[0]);
+    CHECK(XMemcopy_accel_PoolOpenUio(&pool, &eng[0], 1, SLAB_BYTES) == XST_SUCCESS, "map1 not opened");
+    test_copy(eng, n, &pool, 0);
+    test_copy(eng, n, &pool, 1);
+    test_timeout(&eng[0]);
+
+    for (int irq = 0; irq < 2; ++irq) {
+        for (uint32_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k) {
+            for (int threads = 1; threads <= MAX_THREADS; threads *= 2)
+                bench_copy(eng, n, &pool, threads, sizes[k], irq);
+        }
+    }
+
+    XMemcopy_accel_PoolClose(&pool);
+    for (int i = 0; i < n; ++i)
+        XMemcopy_accel_Release(&eng[i]);
+    fake_uio_destroy(tree);
+
+    printf("%d checks, %d failed\n", checks, failures);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,243 @@
+/* C++20 front-end of the Linux driver (xmemcopy_accel.hpp) on a fake UIO
+ * tree (fake_uio.c): xmemcopy::device opens the engines, coroutines await
+ * a single copy and a batch spread over every engine, and run_once()
+ * dispatches the completions from the epoll set of the UIO fds. Also
+ * checks that the device drops an ap_done a previous user left held and
+ * ignores the interrupt of a run it did not start. Prints one line per
+ * failed check and a summary; exit status 0 = pass.
+ */
+#include <coroutine>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <sched.h>
+#include <vector>
+#include <unistd.h>
+#include "xmemcopy_accel.hpp"
+#include "fake_uio.h"
+
+#define UIO_NAME        "memcopy_accel"
+#define DMA_BYTES       (2u << 20)
+#define SLAB_BYTES      (64u << 10)
+#define BATCH           12
+#define GUARD           0x5A
+#define TIMEOUT_MS      1000
+#define WATCHDOG_S      60
+
+static const int engine_nums[] = { 1, 2, 10 };
+#define NUM_ENGINES     (int)(sizeof(engine_nums) / sizeof(engine_nums[0]))
+
+static fake_uio *tree;
+static int checks, failures;
+
+#define CHECK(cond, ...)                                            \
+    do {                                                            \
+        checks++;                                                   \
+        if (!(cond)) {                                              \
+            failures++;                                             \
+            printf("FAIL %s:%d: ", __func__, __LINE__);             \
+            printf(__VA_ARGS__);                                    \
+            printf("\n");                                           \
+        }                                                           \
+    } while (0)
+
+/* Fire-and-forget coroutine: runs until its first co_await, then on the
+   thread that calls run_once() */
+struct task {
+    struct promise_type {
+        task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+static task await_copy(xmemcopy::device& dev, u64 src, u64 dst, u64 len, int* done)
+{
+    co_await dev.copy(src, dst, len);
+    *done = 1;
+}
+
+static task await_batch(xmemcopy::device& dev, std::vector<xmemcopy::copy_desc> descs, int* done)
+{
+    co_await dev.copy(std::span<const xmemcopy::copy_desc>(descs));
+    *done = 1;
+}
+
+/* Dispatch completions until *done, at most TIMEOUT_MS per interrupt */
+static int run_until(xmemcopy::device& dev, const int* done)
+{
+    while (!*done) {
+        if (dev.run_once(TIMEOUT_MS) == 0 && !*done)
+            return 0;
+    }
+    return 1;
+}
+
+static uint64_t jobs(int i)
+{
+    return fake_uio_jobs(tree, engine_nums[i]);
+}
+
+static void fill(uint8_t *p, uint32_t len, uint32_t seed)
+{
+    for (uint32_t b = 0; b < len; ++b)
+        p[b] = (uint8_t)(b * 131u + seed);
+}
+
+/* One awaited copy per length, unaligned, guard bytes around it */
+static void test_single(xmemcopy::device& dev, XMemcopy_accel_Pool *pool)
+{
+    static const uint32_t lens[] = { 1, 7, 64, 4097, 65536 - 16 };
+    XMemcopy_accel_Buf src, dst;
+    uint8_t *s, *d;
+
+    XMemcopy_accel_PoolAlloc(pool, &src);
+    XMemcopy_accel_PoolAlloc(pool, &dst);
+    s = (uint8_t *)src.Virt;
+    d = (uint8_t *)dst.Virt;
+    for (uint32_t k = 0; k < sizeof(lens) / sizeof(lens[0]); ++k) {
+        uint32_t len = lens[k], so = (k * 3) % 8, doff = (k * 5 + 1) % 8;
+        int done = 0;
+
+        fill(s, len + 16, k);
+        memset(d, GUARD, len + 16);
+        XMemcopy_accel_PoolSyncForDevice(pool, &src, 0, len + 16);
+        XMemcopy_accel_PoolSyncForDevice(pool, &dst, 0, len + 16);
+        await_copy(dev, src.Phys + so, dst.Phys + doff, len, &done);
+        CHECK(run_until(dev, &done), "len %u: not resumed", len);
+        if (!done)
+            return;
+        XMemcopy_accel_PoolSyncForCpu(pool, &dst, 0, len + 16);
+        CHECK(memcmp(d + doff, s + so, len) == 0, "len %u: data", len);
+        CHECK(doff == 0 || d[doff - 1] == GUARD, "len %u: head guard", len);
+        CHECK(d[doff + len] == GUARD, "len %u: tail guard", len);
+    }
+    XMemcopy_accel_PoolFree(pool, &src);
+    XMemcopy_accel_PoolFree(pool, &dst);
+}
+
+/* BATCH copies in one co_await: more than there are engines, so some
+   queue and are started by run_once() as engines finish */
+static void test_batch(xmemcopy::device& dev, XMemcopy_accel_Pool *pool)
+{
+    XMemcopy_accel_Buf src[BATCH], dst[BATCH];
+    std::vector<xmemcopy::copy_desc> descs;
+    uint64_t before[NUM_ENGINES];
+    int done = 0;
+
+    for (int i = 0; i < NUM_ENGINES; ++i)
+        before[i] = jobs(i);
+    for (int k = 0; k < BATCH; ++k) {
+        uint32_t len = 1000u * (k + 1) + k;
+
+        XMemcopy_accel_PoolAlloc(pool, &src[k]);
+        XMemcopy_accel_PoolAlloc(pool, &dst[k]);
+        fill((uint8_t *)src[k].Virt, len, 100 + k);
+        memset(dst[k].Virt, GUARD, len + 8);
+        XMemcopy_accel_PoolSyncForDevice(pool, &src[k], 0, len);
+        XMemcopy_accel_PoolSyncForDevice(pool, &dst[k], 0, len + 8);
+        descs.push_back({ src[k].Phys + (k % 8), dst[k].Phys + ((k * 3) % 8), len - (k % 8) });
+    }
+    await_batch(dev, descs, &done);
+    CHECK(run_until(dev, &done), "batch not resumed");
+    for (int k = 0; k < BATCH && done; ++k) {
+        uint8_t *d = (uint8_t *)dst[k].Virt;
+        uint32_t doff = (k * 3) % 8, len = (uint32_t)descs[k].len;
+
+        XMemcopy_accel_PoolSyncForCpu(pool, &dst[k], 0, len + 8);
+        CHECK(memcmp(d + doff, (uint8_t *)src[k].Virt + (k % 8), len) == 0, "batch copy %d: data", k);
+        CHECK(d[doff + len] == GUARD, "batch copy %d: tail guard", k);
+    }
+    for (int i = 0; i < NUM_ENGINES; ++i)
+        CHECK(jobs(i) > before[i], "uio%d ran none of the batch", engine_nums[i]);
+    for (int k = 0; k < BATCH; ++k) {
+        XMemcopy_accel_PoolFree(pool, &src[k]);
+        XMemcopy_accel_PoolFree(pool, &dst[k]);
+    }
+}
+
+/* ap_idle within TIMEOUT_MS; the model sets it after the driver's store */
+static int wait_idle(XMemcopy_accel *inst)
+{
+    for (int ms = 0; ms < TIMEOUT_MS; ++ms) {
+        if (XMemcopy_accel_IsIdle(inst))
+            return 1;
+        usleep(1000);
+    }
+    return 0;
+}
+
+/* Copy on the lowest engine through a second instance of it, outside the
+   device, with guard bytes as data */
+static void start_stray(XMemcopy_accel *inst, XMemcopy_accel_Buf *buf)
+{
+    XMemcopy_accel_TryClaim(inst);
+    XMemcopy_accel_StartCopy(inst, buf->Phys, buf->Phys + 4096, 256);
+}
+
+int main(void)
+{
+    XMemcopy_accel inst;
+    XMemcopy_accel_Pool pool;
+    XMemcopy_accel_Buf buf;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    alarm(WATCHDOG_S);  /* a hang in the driver or the model */
+
+    tree = fake_uio_create();
+    if (!tree) {
+        perror("fake_uio_create");
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < NUM_ENGINES; ++i) {
+        if (fake_uio_add(tree, engine_nums[i], UIO_NAME, DMA_BYTES, 1) < 0) {
+            perror("fake_uio_add");
+            fake_uio_destroy(tree);
+            return EXIT_FAILURE;
+        }
+    }
+    XMemcopy_accel_SetUioPaths(fake_uio_sysfs(tree), fake_uio_dev(tree));
+    if (XMemcopy_accel_Initialize(&inst, UIO_NAME) != XST_SUCCESS ||
+        XMemcopy_accel_PoolOpenUio(&pool, &inst, 1, SLAB_BYTES) != XST_SUCCESS) {
+        printf("FAIL %s: no uio%d\n", __func__, engine_nums[0]);
+        fake_uio_destroy(tree);
+        return EXIT_FAILURE;
+    }
+    XMemcopy_accel_PoolAlloc(&pool, &buf);
+    memset(buf.Virt, GUARD, SLAB_BYTES);
+
+    /* a previous user's run, finished but never continued */
+    start_stray(&inst, &buf);
+    while (!XMemcopy_accel_IsDone(&inst))
+        sched_yield();
+    {
+        xmemcopy::device dev(UIO_NAME);
+
+        CHECK(dev.engines() == NUM_ENGINES, "%d engines", dev.engines());
+        CHECK(wait_idle(&inst), "held ap_done not continued at construction");
+        XMemcopy_accel_Unclaim(&inst);
+
+        test_single(dev, &pool);
+        test_batch(dev, &pool);
+
+        /* an interrupt for a run the device did not start completes nothing */
+        uint32_t irqs = fake_uio_irqs(tree, engine_nums[0]);
+        start_stray(&inst, &buf);
+        CHECK(dev.run_once(TIMEOUT_MS) == 0, "stray run completed a copy");
+        CHECK(fake_uio_irqs(tree, engine_nums[0]) > irqs, "no interrupt for the stray run");
+        CHECK(wait_idle(&inst), "stray run not continued");
+        XMemcopy_accel_Unclaim(&inst);
+        test_single(dev, &pool);
+    }
+
+    XMemcopy_accel_PoolFree(&pool, &buf);
+    XMemcopy_accel_PoolClose(&pool);
+    XMemcopy_accel_Release(&inst);
+    fake_uio_destroy(tree);
+
+    printf("%d checks, %d failed\n", checks, failures);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -1,6 +1,7 @@
 #ifndef MEMCOPY_ACCEL_H_
 #define MEMCOPY_ACCEL_H_
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -16,15 +17,200 @@
 #define MEMCOPY_ACCEL_GIE_OFFSET    0x04u   /* Global Interrupt Enable (if created) */
 #define MEMCOPY_ACCEL_IER_OFFSET    0x08u   /* IP Interrupt Enable */
 #define MEMCOPY_ACCEL_ISR_OFFSET    0x0Cu   /* IP Interrupt Status */
-#define MEMCOPY_ACCEL_SRC_OFFSET    0x10u   /* src (lower 32 bits) */
-#define MEMCOPY_ACCEL_DST_OFFSET    0x1cu   /* dst (lower 32 bits) */
-#define MEMCOPY_ACCEL_LEN_OFFSET    0x28u   /* len (bytes) */
+#define MEMCOPY_ACCEL_SRC_OFFSET    0x10u   /* src (64-bit: low word, high word at +4) */
+#define MEMCOPY_ACCEL_DST_OFFSET    0x1cu   /* dst (64-bit) */
+#define MEMCOPY_ACCEL_LEN_OFFSET    0x28u   /* len (bytes, 64-bit) */
+#define MEMCOPY_ACCEL_SRC_OFF_OFFSET    0x34u   /* src byte offset within a bus beat */
+#define MEMCOPY_ACCEL_DST_OFF_OFFSET    0x3cu   /* dst byte offset within a bus beat */
+#define MEMCOPY_ACCEL_DST_BYTES_OFFSET  0x44u   /* dst byte view (64-bit), same address as dst */
+#define MEMCOPY_ACCEL_OP_OFFSET     0x50u   /* operation (MEMCOPY_OP_*) */
+#define MEMCOPY_ACCEL_DESC_OFFSET   0x58u   /* descriptor table (64-bit) */
+#define MEMCOPY_ACCEL_ROWS_OFFSET       0x64u   /* 2D: number of rows */
+#define MEMCOPY_ACCEL_ROW_BYTES_OFFSET  0x6cu   /* 2D: bytes per row */
+#define MEMCOPY_ACCEL_SRC_STRIDE_OFFSET 0x74u   /* 2D: source row pitch (bytes) */
+#define MEMCOPY_ACCEL_DST_STRIDE_OFFSET 0x7cu   /* 2D: destination row pitch (bytes) */
+#define MEMCOPY_ACCEL_FILL_OFFSET       0x84u   /* fill word / pattern base */
+#define MEMCOPY_ACCEL_CRC_OFFSET        0x8cu   /* read-only: CRC-32 of the bytes written by the last run */
+#define MEMCOPY_ACCEL_CRC_CTRL_OFFSET   0x90u   /* bit 0: CRC valid (ap_vld) */
+#define MEMCOPY_ACCEL_CMP_MATCH_OFFSET  0x94u   /* compare: 1 = equal */
+#define MEMCOPY_ACCEL_CMP_FIRST_OFFSET  0x9cu   /* compare: first differing byte offset (64-bit) */
+#define MEMCOPY_ACCEL_CMP_COUNT_OFFSET  0xa8u   /* compare: number of differing bytes (64-bit) */
+#define MEMCOPY_ACCEL_PERF_CYCLES_OFFSET    0xb4u   /* perf: clock cycles of the last run */
+#define MEMCOPY_ACCEL_PERF_RD_BEATS_OFFSET  0xbcu   /* perf: AXI read data beats */
+#define MEMCOPY_ACCEL_PERF_WR_BEATS_OFFSET  0xc4u   /* perf: AXI write data beats */
+#define MEMCOPY_ACCEL_PERF_STALL_OFFSET     0xccu   /* perf: cycles beyond one beat per cycle */
+#define MEMCOPY_ACCEL_CPL_OFFSET        0xd4u   /* ring: completion ring (64-bit) */
+#define MEMCOPY_ACCEL_RING_PROD_OFFSET  0xe0u   /* ring: address of the producer index (64-bit) */
+#define MEMCOPY_ACCEL_IRQ_COUNT_OFFSET  0xecu   /* ring: completions per interrupt */
+#define MEMCOPY_ACCEL_IRQ_IDLE_OFFSET   0xf4u   /* ring: empty-ring polls before an early interrupt */
+
+/* AXI data width of the IP in bytes: MEMCOPY_BUS_WIDTH / 8 of the HLS build.
+   src/dst registers take the bus-aligned base, the low bits go to *_OFF. */
+#ifndef MEMCOPY_ACCEL_BUS_BYTES
+#define MEMCOPY_ACCEL_BUS_BYTES     8u
+#endif
+
+/* Operations */
+#define MEMCOPY_OP_COPY             0u      /* single copy: src, dst, len */
+#define MEMCOPY_OP_SG               1u      /* descriptor chain at desc, len = descriptor count */
+#define MEMCOPY_OP_2D               2u      /* rows x row_bytes with src/dst row pitch */
+#define MEMCOPY_OP_FILL             3u      /* write-only: every 32-bit word = fill */
+#define MEMCOPY_OP_PATTERN          4u      /* write-only: 32-bit word i = fill + i */
+#define MEMCOPY_OP_CMP              5u      /* read-only: compare src and dst */
+#define MEMCOPY_OP_SWAP16           6u      /* copy, byte-swap each 16-bit element */
+#define MEMCOPY_OP_SWAP32           7u      /* copy, byte-swap each 32-bit element */
+#define MEMCOPY_OP_SWAP64           8u      /* copy, byte-swap each 64-bit element */
+#define MEMCOPY_OP_WIDEN16          9u      /* u8 -> u16, writes 2 * len bytes */
+#define MEMCOPY_OP_WIDEN32          10u     /* u8 -> u32, writes 4 * len bytes */
+#define MEMCOPY_OP_RING             11u     /* command ring in DDR, see memcopy_ring_t */
+
+#define MEMCOPY_CMP_NONE            0xFFFFFFFFFFFFFFFFull /* cmp_first when the buffers match */
+
+/* Scatter-gather descriptor, 32 bytes, read by the IP over AXI_SRC.
+   The chain ends at the descriptor with MEMCOPY_DESC_LAST or after
+   the count written to len, whichever comes first. */
+#define MEMCOPY_DESC_LAST           0x1u
+#define MEMCOPY_DESC_STOP           0x2u    /* ring: IP goes idle after this command */
+#define MEMCOPY_DESC_MAX_LEN        0x80000000u /* memcopy_chain_add() splits longer fragments */
+
+typedef struct {
+    uint64_t src;       /* source byte address */
+    uint64_t dst;       /* destination byte address */
+    uint32_t len;       /* bytes */
+    uint32_t flags;     /* MEMCOPY_DESC_* */
+    uint64_t cookie;    /* ring: returned in the completion entry */
+} __attribute__((aligned(32))) memcopy_desc_t;
+
+/* Descriptor chain built in caller-owned memory (32-byte aligned) */
+typedef struct {
+    memcopy_desc_t *desc;
+    uint32_t count;
+    uint32_t max;
+} memcopy_chain_t;
+
+/* Command ring. Commands are memcopy_desc_t slots in DDR; the IP polls
+   prod (the doorbell: a plain memory write, no register access) and writes
+   one memcopy_cpl_t per command to cpl[1 + index % slots]; cpl[0] is the
+   IP's consumer index. The IP interrupts after irq_count completions, or
+   after irq_idle polls of an empty ring with completions pending, and
+   keeps running with auto_restart until a MEMCOPY_DESC_STOP command. */
+#define MEMCOPY_CPL_DONE            0x1u    /* status: command executed */
+#define MEMCOPY_CPL_STOP            0x2u    /* status: it was the stop command */
+
+typedef struct {
+    uint64_t cookie;    /* from the command */
+    uint32_t status;    /* MEMCOPY_CPL_* */
+    uint32_t crc;       /* CRC-32 of the bytes written */
+    uint32_t len;       /* bytes */
+    uint32_t seq;       /* command index + 1 */
+    uint64_t reserved;
+} __attribute__((aligned(32))) memcopy_cpl_t;
+
+typedef struct {
+    volatile uint32_t prod[8] __attribute__((aligned(32)));  /* [0] = producer index, own cache line */
+    memcopy_desc_t *cmd;    /* slots commands */
+    memcopy_cpl_t *cpl;     /* slots + 1 entries */
+    uint32_t slots;         /* power of two */
+    uint32_t head;          /* next command index */
+    uint32_t tail;          /* next completion to reap */
+    uint32_t ch;
+} memcopy_ring_t;
+
+/* Per-run performance counters (kernel clock cycles and AXI data beats).
+   A partial head/tail beat is written as one single-byte beat per byte. */
+typedef struct {
+    uint32_t cycles;    /* ap_start to end of the operation */
+    uint32_t rd_beats;  /* AXI_SRC and AXI_DST read beats, incl. descriptors */
+    uint32_t wr_beats;  /* AXI_DST write beats */
+    uint32_t stall;     /* cycles - max(rd_beats, wr_beats) */
+} memcopy_perf_t;
+
+/* Asynchronous jobs. memcopy_submit() queues a caller-owned job on a
+   channel and returns a ticket at once; memcopy_ch_irq(), called from the
+   channel's interrupt handler, collects the results of the finished job,
+   starts the next queued one and runs the callback (in interrupt context).
+   memcopy_wait() sleeps until a ticket is done. The job must stay valid
+   until then, and the caches are the caller's, as for the start calls.
+   Do not use the start calls on a channel while it has jobs queued. */
+typedef struct memcopy_job memcopy_job_t;
+typedef void (*memcopy_job_cb_t)(memcopy_job_t *job, void *arg);
+typedef uint32_t memcopy_ticket_t;      /* sequence << 4 | MEMCOPY_TICKET_VALID | channel */
+#define MEMCOPY_TICKET_NONE         0u  /* queue full or unsupported op */
+#define MEMCOPY_TICKET_VALID        8u  /* set in every issued ticket */
+
+#ifndef MEMCOPY_JOB_QUEUE_DEPTH
+#define MEMCOPY_JOB_QUEUE_DEPTH     16u /* jobs per channel, power of two */
+#endif
+
+/* Job queue statistics of one channel */
+typedef struct {
+    uint32_t submitted;         /* jobs accepted by memcopy_submit() */
+    uint32_t rejected;          /* submits refused with the queue full */
+    uint32_t completed;
+    uint32_t started_direct;    /* started by memcopy_submit() on a free channel */
+    uint32_t started_chained;   /* started from the ISR on the previous ap_done */
+    uint32_t high_water;        /* most jobs queued or in the IP at once */
+    uint32_t depth;             /* jobs queued or in the IP now */
+} memcopy_queue_stats_t;
+
+struct memcopy_job {
+    /* request */
+    uint32_t op;            /* MEMCOPY_OP_*, not MEMCOPY_OP_RING */
+    uint64_t src;           /* compare: first buffer */
+    uint64_t dst;           /* compare: second buffer */
+    uint64_t len;
+    uint32_t fill;          /* MEMCOPY_OP_FILL / _PATTERN value */
+    uint32_t rows, row_bytes, src_stride, dst_stride;  /* MEMCOPY_OP_2D */
+    memcopy_chain_t *chain; /* MEMCOPY_OP_SG */
+    memcopy_job_cb_t cb;    /* completion callback, may be NULL */
+    void *arg;
+    /* result, valid once done is set */
+    volatile uint32_t done;
+    uint32_t crc;
+    bool cmp_match;
+    uint64_t cmp_first;
+    uint64_t cmp_count;
+    memcopy_perf_t perf;
+};
+
+/* Large copies are split into chunks so the cache maintenance of the
+   neighbouring chunks overlaps the copy of the current one */
+#ifndef MEMCOPY_CHUNK_DEFAULT
+#define MEMCOPY_CHUNK_DEFAULT       (16u * 1024u)   /* bytes, chunk = 0 */
+#endif
+#ifndef MEMCOPY_CHUNK_TIMEOUT_US
+#define MEMCOPY_CHUNK_TIMEOUT_US    2000000u        /* per chunk */
+#endif
+#define MEMCOPY_CACHE_LINE          32u             /* Cortex-A9 L1/L2 line */
+
+/* CPU/accelerator dispatch. memcopy_auto() copies with the CPU below
+   threshold bytes and with channel 0 from there on; memcopy_auto_calibrate()
+   times both paths for each table size and sets threshold to the size from
+   which the accelerator (cache maintenance and interrupt included) wins for
+   every larger size. Until then threshold is MEMCOPY_AUTO_DEFAULT_THRESHOLD. */
+#define MEMCOPY_AUTO_POINTS         11u     /* 64 B .. 64 KiB, doubling */
+#ifndef MEMCOPY_AUTO_DEFAULT_THRESHOLD
+#define MEMCOPY_AUTO_DEFAULT_THRESHOLD  4096u
+#endif
+
+typedef struct {
+    uint32_t len;           /* bytes */
+    uint32_t cpu_ticks;     /* XTime counts, best of the repeats */
+    uint32_t accel_ticks;
+} memcopy_auto_point_t;
+
+typedef struct {
+    memcopy_auto_point_t point[MEMCOPY_AUTO_POINTS];
+    uint32_t count;         /* points measured */
+    uint32_t threshold;     /* smallest length copied by the accelerator */
+} memcopy_auto_table_t;
 
 /* Control bits */
 #define MEMCOPY_AP_START_MASK       0x01u
 #define MEMCOPY_AP_DONE_MASK        0x02u
 #define MEMCOPY_AP_IDLE_MASK        0x04u
 #define MEMCOPY_AP_READY_MASK       0x08u
+#define MEMCOPY_AP_CONTINUE_MASK    0x10u   /* ap_ctrl_chain: acknowledge ap_done */
 
 #define MEMCOPY_AUTO_RESTART_MASK   0x80u
 
@@ -38,7 +224,9 @@
 /* Global Interrupt Enable bit mask */
 #define MEMCOPY_GIE_ENABLE_MASK		0x01u
 
-/* IP Interrupt Enable bit mask*/
+/* IP Interrupt Enable bit mask. These are the two interrupt sources of
+   one instance, ap_done (bit 0) and ap_ready (bit 1), not two engines:
+   every channel has its own IER/ISR. */
 #define MEMCOPY_IER_CHAN0_INT_EN_MASK               0x01u
 #define MEMCOPY_IER_CHAN1_INT_EN_MASK               0x02u
 
@@ -46,18 +234,126 @@
 #define MEMCOPY_ISR_CHAN0_INT_CLEAR_MASK            0x01u
 
 
+/* Channels. Each channel is one memcopy_accel instance in the block design
+   with its own CTRL_BUS register set, ap_done and interrupt line, so jobs on
+   different channels run concurrently (give each instance its own pair of
+   HP ports, or let them share one through the interconnect). The
+   memcopy_ch_* calls take the channel; the memcopy_accel_* calls below are
+   channel 0. A channel must only be driven from one context at a time. */
+#ifndef MEMCOPY_ACCEL_NUM_CHANNELS
+#define MEMCOPY_ACCEL_NUM_CHANNELS  2u
+#endif
+
+/* Cache coherency of the channels' masters. 0: HP ports, the driver and
+   the caller flush/invalidate the buffers around every job. 1: the IP is
+   built for the ACP (see src/Vitis-HLS/memcopy_acp.tcl) and the
+   memcopy_ch_cache_* calls do nothing. memcopy_ch_set_coherent() changes
+   one channel at run time. */
+#ifndef MEMCOPY_ACCEL_COHERENT
+#define MEMCOPY_ACCEL_COHERENT      0
+#endif
+
+/* Block-level protocol the IP was built with, as MEMCOPY_CTRL_CHAIN of
+   src/Vitis-HLS/memcopy_accel.h. 1: ap_ctrl_chain, a second job is latched
+   while one runs and ap_done is held until ap_continue. 0: ap_ctrl_hs, one
+   job at a time and ap_done is cleared when AP_CTRL is read. */
+#ifndef MEMCOPY_ACCEL_CTRL_CHAIN
+#define MEMCOPY_ACCEL_CTRL_CHAIN    1
+#endif
+
 /* Prototypes */
-void memcopy_accel_init(uint32_t baseaddr);
-void memcopy_accel_start(uint32_t src_addr, uint32_t dst_addr, uint32_t len);
-bool memcopy_accel_is_done(void);
-void memcopy_accel_wait_done(void);
+void memcopy_ch_init(uint32_t ch, uintptr_t baseaddr);
+void memcopy_ch_start(uint32_t ch, uint64_t src_addr, uint64_t dst_addr, uint64_t len);
+void memcopy_ch_start_2d(uint32_t ch, uint64_t src_addr, uint64_t dst_addr, uint32_t rows,
+                         uint32_t row_bytes, uint32_t src_stride, uint32_t dst_stride);
+void memcopy_ch_start_transform(uint32_t ch, uint64_t src_addr, uint64_t dst_addr, uint64_t len, uint32_t op);
+void memcopy_ch_start_fill(uint32_t ch, uint64_t dst_addr, uint64_t len, uint32_t value, bool incr);
+bool memcopy_ch_is_done(uint32_t ch);
+uint32_t memcopy_ch_get_crc(uint32_t ch);
+void memcopy_ch_start_compare(uint32_t ch, uint64_t a_addr, uint64_t b_addr, uint64_t len);
+bool memcopy_ch_get_compare(uint32_t ch, uint64_t *first, uint64_t *count);
+void memcopy_ch_get_perf(uint32_t ch, memcopy_perf_t *perf);
+bool memcopy_ch_is_ready(uint32_t ch);
+void memcopy_ch_continue(uint32_t ch);
+void memcopy_ch_set_auto_restart(uint32_t ch, bool enable);
+void memcopy_ch_wait_done(uint32_t ch);
+void memcopy_ch_chain_submit(uint32_t ch, memcopy_chain_t *chain);
+int memcopy_ch_copy_polling(uint32_t ch, uint64_t src_addr, uint64_t dst_addr, uint64_t len);
+void memcopy_ch_interrupt_enable(uint32_t ch);
+void memcopy_ch_interrupt_clear(uint32_t ch);
+
+/* Cache maintenance for buffers a channel reads or writes: skipped on a
+   coherent channel */
+void memcopy_ch_set_coherent(uint32_t ch, bool enable);
+bool memcopy_ch_is_coherent(uint32_t ch);
+void memcopy_ch_cache_flush(uint32_t ch, const void *buf, size_t len);
+void memcopy_ch_cache_invalidate(uint32_t ch, void *buf, size_t len);
+
+/* Command ring: start once, add commands, publish them with one doorbell,
+   reap completions from the ISR or a loop; stop enqueues a stop command */
+int memcopy_ring_start(memcopy_ring_t *ring, uint32_t ch, memcopy_desc_t *cmd, memcopy_cpl_t *cpl,
+                       uint32_t slots, uint32_t irq_count, uint32_t irq_idle);
+int memcopy_ring_add(memcopy_ring_t *ring, uint64_t src_addr, uint64_t dst_addr, uint32_t len, uint64_t cookie);
+void memcopy_ring_doorbell(memcopy_ring_t *ring);
+bool memcopy_ring_reap(memcopy_ring_t *ring, memcopy_cpl_t *cpl);
+int memcopy_ring_stop(memcopy_ring_t *ring);
+
+/* Jobs: fill in a job (memcopy_job_init sets op, addresses and length and
+   clears the rest), submit it, then wait for the ticket or take the callback */
+void memcopy_job_init(memcopy_job_t *job, uint32_t op, uint64_t src_addr, uint64_t dst_addr, uint64_t len);
+memcopy_ticket_t memcopy_submit(uint32_t ch, memcopy_job_t *job);
+bool memcopy_ticket_done(memcopy_ticket_t ticket);
+int memcopy_wait(memcopy_ticket_t ticket, uint32_t timeout_us);
+memcopy_job_t *memcopy_ch_irq(uint32_t ch);
+void memcopy_ch_get_queue_stats(uint32_t ch, memcopy_queue_stats_t *stats);
+void memcopy_ch_reset_queue_stats(uint32_t ch);
+
+/* Scatter-gather chain: init, add fragments, then submit as one ap_start */
+void memcopy_chain_init(memcopy_chain_t *chain, memcopy_desc_t *desc, uint32_t max);
+int memcopy_chain_add(memcopy_chain_t *chain, uint64_t src_addr, uint64_t dst_addr, uint64_t len);
+
+/* Cached buffers, any size: flush, copy, invalidate, pipelined per chunk */
+int memcopy_ch_copy_chunked(uint32_t ch, void *dst, const void *src, size_t len, uint32_t chunk);
+
+/* CPU/accelerator dispatch: call calibrate once, with interrupts set up;
+   scratch buffers of max_len bytes, 32-byte aligned */
+void memcopy_cpu(void *dst, const void *src, size_t len);
+int memcopy_auto(void *dst, const void *src, size_t len);
+int memcopy_auto_calibrate(void *scratch_src, void *scratch_dst, uint32_t max_len);
+const memcopy_auto_table_t *memcopy_auto_get_table(void);
+
+/* Channel 0 */
+static inline void memcopy_accel_init(uintptr_t baseaddr)
+{ memcopy_ch_init(0, baseaddr); }
+static inline void memcopy_accel_start(uint64_t src_addr, uint64_t dst_addr, uint64_t len)
+{ memcopy_ch_start(0, src_addr, dst_addr, len); }
+static inline void memcopy_accel_start_2d(uint64_t src_addr, uint64_t dst_addr, uint32_t rows,
+                                          uint32_t row_bytes, uint32_t src_stride, uint32_t dst_stride)
+{ memcopy_ch_start_2d(0, src_addr, dst_addr, rows, row_bytes, src_stride, dst_stride); }
+static inline void memcopy_accel_start_transform(uint64_t src_addr, uint64_t dst_addr, uint64_t len, uint32_t op)
+{ memcopy_ch_start_transform(0, src_addr, dst_addr, len, op); }
+static inline void memcopy_accel_start_fill(uint64_t dst_addr, uint64_t len, uint32_t value, bool incr)
+{ memcopy_ch_start_fill(0, dst_addr, len, value, incr); }
+static inline bool memcopy_accel_is_done(void) { return memcopy_ch_is_done(0); }
+static inline uint32_t memcopy_accel_get_crc(void) { return memcopy_ch_get_crc(0); }
+static inline void memcopy_accel_start_compare(uint64_t a_addr, uint64_t b_addr, uint64_t len)
+{ memcopy_ch_start_compare(0, a_addr, b_addr, len); }
+static inline bool memcopy_accel_get_compare(uint64_t *first, uint64_t *count)
+{ return memcopy_ch_get_compare(0, first, count); }
+static inline void memcopy_accel_get_perf(memcopy_perf_t *perf) { memcopy_ch_get_perf(0, perf); }
+static inline bool memcopy_accel_is_ready(void) { return memcopy_ch_is_ready(0); }
+static inline void memcopy_accel_continue(void) { memcopy_ch_continue(0); }
+static inline void memcopy_accel_set_auto_restart(bool enable) { memcopy_ch_set_auto_restart(0, enable); }
+static inline void memcopy_accel_wait_done(void) { memcopy_ch_wait_done(0); }
+static inline void memcopy_chain_submit(memcopy_chain_t *chain) { memcopy_ch_chain_submit(0, chain); }
 
 /* High-level convenience function (blocking) */
-int memcopy_accel_copy_polling(uint32_t src_addr, uint32_t dst_addr, uint32_t len);
+static inline int memcopy_accel_copy_polling(uint64_t src_addr, uint64_t dst_addr, uint64_t len)
+{ return memcopy_ch_copy_polling(0, src_addr, dst_addr, len); }
 
 /* New: interrupt helpers */
-void memcopy_accel_interrupt_enable(void);
-void memcopy_accel_interrupt_clear(void);
+static inline void memcopy_accel_interrupt_enable(void) { memcopy_ch_interrupt_enable(0); }
+static inline void memcopy_accel_interrupt_clear(void) { memcopy_ch_interrupt_clear(0); }
 
 
 
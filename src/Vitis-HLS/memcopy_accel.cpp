@@ -2,16 +2,17 @@
 #include <hls_stream.h>
 #include <ap_int.h>
 #include <string.h>
+#include "memcopy_accel.h"
 
-#define BURST_LEN 32  // number of 32-bit words per burst
-
-void memcopy_accel(
+void memcopy_accel_word(
     uint32_t* src,   // AXI4 Master port for source DDR
     uint32_t* dst,   // AXI4 Master port for destination DDR
     uint32_t len     // Number of bytes to copy
 ) {
-#pragma HLS INTERFACE m_axi     port=src offset=slave bundle=AXI_SRC depth=1024
-#pragma HLS INTERFACE m_axi     port=dst offset=slave bundle=AXI_DST depth=1024
+#pragma HLS INTERFACE m_axi     port=src offset=slave bundle=AXI_SRC depth=MEMCOPY_AXI_DEPTH \
+    max_read_burst_length=MEMCOPY_MAX_BURST num_read_outstanding=MEMCOPY_NUM_OUTSTANDING
+#pragma HLS INTERFACE m_axi     port=dst offset=slave bundle=AXI_DST depth=MEMCOPY_AXI_DEPTH \
+    max_write_burst_length=MEMCOPY_MAX_BURST num_write_outstanding=MEMCOPY_NUM_OUTSTANDING
 #pragma HLS INTERFACE s_axilite port=src       bundle=CTRL_BUS
 #pragma HLS INTERFACE s_axilite port=dst       bundle=CTRL_BUS
 #pragma HLS INTERFACE s_axilite port=len       bundle=CTRL_BUS
@@ -31,3 +32,160 @@ copy_loop:
         memcpy((uint32_t*)&dst[i], buffer, chunk * sizeof(uint32_t));
     }
 }
+
+void memcopy_accel_wide(
+    memcopy_beat_t* src,   // AXI4 Master port for source DDR (MEMCOPY_BUS_WIDTH bits)
+    memcopy_beat_t* dst,   // AXI4 Master port for destination DDR (MEMCOPY_BUS_WIDTH bits)
+    uint32_t len           // Number of bytes to copy
+) {
+#pragma HLS INTERFACE m_axi     port=src offset=slave bundle=AXI_SRC depth=MEMCOPY_AXI_DEPTH \
+    max_read_burst_length=MEMCOPY_MAX_BURST num_read_outstanding=MEMCOPY_NUM_OUTSTANDING
+#pragma HLS INTERFACE m_axi     port=dst offset=slave bundle=AXI_DST depth=MEMCOPY_AXI_DEPTH \
+    max_write_burst_length=MEMCOPY_MAX_BURST num_write_outstanding=MEMCOPY_NUM_OUTSTANDING
+#pragma HLS INTERFACE s_axilite port=src       bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=dst       bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=len       bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=return    bundle=CTRL_BUS
+
+    memcopy_wide<MEMCOPY_BUS_WIDTH>(src, dst, len);
+}
+
+void memcopy_accel_dataflow(
+    memcopy_beat_t* src,   // AXI4 Master port for source DDR (MEMCOPY_BUS_WIDTH bits)
+    memcopy_beat_t* dst,   // AXI4 Master port for destination DDR (MEMCOPY_BUS_WIDTH bits)
+    uint32_t len           // Number of bytes to copy
+) {
+#pragma HLS INTERFACE m_axi     port=src offset=slave bundle=AXI_SRC depth=MEMCOPY_AXI_DEPTH \
+    max_read_burst_length=MEMCOPY_MAX_BURST num_read_outstanding=MEMCOPY_NUM_OUTSTANDING
+#pragma HLS INTERFACE m_axi     port=dst offset=slave bundle=AXI_DST depth=MEMCOPY_AXI_DEPTH \
+    max_write_burst_length=MEMCOPY_MAX_BURST num_write_outstanding=MEMCOPY_NUM_OUTSTANDING
+#pragma HLS INTERFACE s_axilite port=src       bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=dst       bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=len       bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=return    bundle=CTRL_BUS
+
+    memcopy_dataflow<MEMCOPY_BUS_WIDTH>(src, dst, len);
+}
+
+// The operation selected by op; posts its beat counts to done when finished
+static void memcopy_accel_op(memcopy_beat_t* src, memcopy_beat_t* dst, uint64_t len,
+                             uint32_t src_off, uint32_t dst_off, uint8_t* dst_bytes,
+                             uint32_t op, memcopy_beat_t* desc,
+                             uint32_t rows, uint32_t row_bytes, uint32_t src_stride, uint32_t dst_stride,
+                             uint32_t fill, uint32_t* crc,
+                             uint32_t* cmp_match, uint64_t* cmp_first, uint64_t* cmp_count,
+                             memcopy_beat_t* cpl, volatile uint32_t* ring_prod,
+                             uint32_t irq_count, uint32_t irq_idle,
+                             hls::stream<memcopy_perf_t>& done) {
+    const int W = MEMCOPY_BUS_WIDTH;
+    uint32_t state = MEMCOPY_CRC_INIT;
+    memcopy_perf_t perf = { 0, 0 };
+
+    if (op == MEMCOPY_OP_SG)
+        memcopy_sg<W>(desc, src, dst, dst_bytes, (uint32_t)len, state, perf);
+    else if (op == MEMCOPY_OP_RING) {
+        uint32_t last = 0;
+        memcopy_ring<W>(desc, src, dst, dst_bytes, cpl, ring_prod, (uint32_t)len, irq_count, irq_idle, last, perf);
+        state = ~last;
+    }
+    else if (op == MEMCOPY_OP_2D)
+        memcopy_2d<W>(src, dst, dst_bytes, src_off, dst_off,
+                      rows, row_bytes, src_stride, dst_stride, state, perf);
+    else if (op == MEMCOPY_OP_FILL || op == MEMCOPY_OP_PATTERN) {
+        memcopy_fill<W>(dst, dst_bytes, len, dst_off, fill, op == MEMCOPY_OP_PATTERN, state);
+        perf.wr_beats = memcopy_write_beats<W>(dst_off, len);
+    } else if (op == MEMCOPY_OP_CMP) {
+        memcopy_len_t first, count;
+        memcopy_compare<W>(src, dst, len, src_off, dst_off, first, count);
+        *cmp_match = (count == 0) ? 1 : 0;
+        *cmp_first = first;
+        *cmp_count = count;
+        perf.rd_beats = memcopy_read_beats<W>(src_off, len) + memcopy_read_beats<W>(dst_off, len);
+    } else if (op >= MEMCOPY_OP_SWAP16 && op <= MEMCOPY_OP_WIDEN32) {
+        memcopy_transform<W>(src, dst, dst_bytes, len, src_off, dst_off, op, state);
+        perf.rd_beats = memcopy_read_beats<W>(src_off, len);
+        perf.wr_beats = memcopy_write_beats<W>(dst_off, len * memcopy_widen_factor(op));
+    } else {
+        memcopy_unaligned<W>(src, dst, dst_bytes, len, src_off, dst_off, MEMCOPY_CRC_INIT, state);
+        perf.rd_beats = memcopy_read_beats<W>(src_off, len);
+        perf.wr_beats = memcopy_write_beats<W>(dst_off, len);
+    }
+
+    *crc = ~state;
+    done.write(perf);
+}
+
+void memcopy_accel(
+    memcopy_beat_t* src,   // AXI4 Master port for source DDR, bus-aligned base
+    memcopy_beat_t* dst,   // AXI4 Master port for destination DDR, bus-aligned base
+    uint64_t len,          // Number of bytes to copy (any value); SG/RING: descriptor/slot count
+    uint32_t src_off,      // Byte offset of the first source byte from src
+    uint32_t dst_off,      // Byte offset of the first destination byte from dst
+    uint8_t* dst_bytes,    // Byte view of dst (same address) for strobed head/tail writes
+    uint32_t op,           // MEMCOPY_OP_*
+    memcopy_beat_t* desc,  // Descriptor table (MEMCOPY_OP_SG), read over AXI_SRC
+    uint32_t rows,         // MEMCOPY_OP_2D: number of rows
+    uint32_t row_bytes,    // MEMCOPY_OP_2D: bytes per row
+    uint32_t src_stride,   // MEMCOPY_OP_2D: source row pitch in bytes
+    uint32_t dst_stride,   // MEMCOPY_OP_2D: destination row pitch in bytes
+    uint32_t fill,         // MEMCOPY_OP_FILL/PATTERN: fill word / pattern base
+    uint32_t* crc,         // Read-only: CRC-32 of all bytes written by this call
+    uint32_t* cmp_match,   // MEMCOPY_OP_CMP result: 1 = equal
+    uint64_t* cmp_first,   // MEMCOPY_OP_CMP result: first differing byte offset
+    uint64_t* cmp_count,   // MEMCOPY_OP_CMP result: number of differing bytes
+    uint32_t* perf_cycles,   // Read-only: clock cycles from ap_start to the end of the operation
+    uint32_t* perf_rd_beats, // Read-only: AXI read data beats (AXI_SRC + AXI_DST)
+    uint32_t* perf_wr_beats, // Read-only: AXI write data beats
+    uint32_t* perf_stall,    // Read-only: perf_cycles beyond one beat per cycle
+    memcopy_beat_t* cpl,   // MEMCOPY_OP_RING: completion ring, written over AXI_DST
+    volatile uint32_t* ring_prod, // MEMCOPY_OP_RING: producer index in DDR, polled over AXI_SRC
+    uint32_t irq_count,    // MEMCOPY_OP_RING: completions per run (interrupt)
+    uint32_t irq_idle      // MEMCOPY_OP_RING: empty-ring polls before returning with completions pending
+) {
+#pragma HLS INTERFACE m_axi     port=src offset=slave bundle=AXI_SRC depth=MEMCOPY_AXI_DEPTH \
+    max_read_burst_length=MEMCOPY_MAX_BURST num_read_outstanding=MEMCOPY_NUM_OUTSTANDING
+#pragma HLS INTERFACE m_axi     port=dst offset=slave bundle=AXI_DST depth=MEMCOPY_AXI_DEPTH \
+    max_write_burst_length=MEMCOPY_MAX_BURST num_write_outstanding=MEMCOPY_NUM_OUTSTANDING
+#pragma HLS INTERFACE m_axi     port=dst_bytes offset=slave bundle=AXI_DST depth=MEMCOPY_AXI_DEPTH
+#pragma HLS INTERFACE m_axi     port=desc offset=slave bundle=AXI_SRC depth=256
+#pragma HLS INTERFACE m_axi     port=cpl offset=slave bundle=AXI_DST depth=256
+#pragma HLS INTERFACE m_axi     port=ring_prod offset=slave bundle=AXI_SRC depth=1
+#pragma HLS INTERFACE s_axilite port=src       bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=dst       bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=len       bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=src_off   bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=dst_off   bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=dst_bytes bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=op        bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=desc      bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=rows      bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=row_bytes bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=src_stride bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=dst_stride bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=fill      bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=crc       bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=cmp_match bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=cmp_first bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=cmp_count bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=perf_cycles   bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=perf_rd_beats bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=perf_wr_beats bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=perf_stall    bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=cpl       bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=ring_prod bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=irq_count bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=irq_idle  bundle=CTRL_BUS
+#pragma HLS INTERFACE s_axilite port=return    bundle=CTRL_BUS
+#if MEMCOPY_CTRL_CHAIN
+#pragma HLS INTERFACE ap_ctrl_chain port=return bundle=CTRL_BUS
+#endif
+
+#pragma HLS DATAFLOW
+    hls::stream<memcopy_perf_t> done("perf_done");
+#pragma HLS STREAM variable=done depth=2
+
+    memcopy_accel_op(src, dst, len, src_off, dst_off, dst_bytes, op, desc,
+                     rows, row_bytes, src_stride, dst_stride, fill, crc,
+                     cmp_match, cmp_first, cmp_count, cpl, ring_prod, irq_count, irq_idle, done);
+    memcopy_cycle_counter(done, perf_cycles, perf_rd_beats, perf_wr_beats, perf_stall);
+}
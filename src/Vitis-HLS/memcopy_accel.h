@@ -0,0 +1,782 @@
+#pragma once
+#include <stdint.h>
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#ifndef BURST_LEN
+#define BURST_LEN 32  // number of 32-bit words per burst
+#endif
+
+// Cache-coherent build for the Zynq-7000 ACP (-DMEMCOPY_ACP=1). The
+// AxCACHE/AxUSER values of the m_axi adapters are IP parameters, not C:
+// memcopy_acp.tcl sets them on the block design cell and routes both
+// masters to S_AXI_ACP. Here the knob only picks the defaults that suit
+// the port: 64-bit, one 32-byte cache line per burst, which the SCU
+// handles without a read-modify-write.
+#ifndef MEMCOPY_ACP
+#define MEMCOPY_ACP 0
+#endif
+#if MEMCOPY_ACP
+#ifndef MEMCOPY_BUS_WIDTH
+#define MEMCOPY_BUS_WIDTH 64
+#endif
+#ifndef MEMCOPY_MAX_BURST
+#define MEMCOPY_MAX_BURST 4
+#endif
+#endif
+
+// Data width of the wide kernel's AXI_SRC/AXI_DST masters.
+// 64 matches the S_AXI_HP ports on Zynq-7000, 128 targets the MPSoC HP ports.
+#ifndef MEMCOPY_BUS_WIDTH
+#define MEMCOPY_BUS_WIDTH 64
+#endif
+
+// AXI master knobs applied to the m_axi pragmas of every top function.
+// Override from the cflags; sweep_burst.tcl builds one variant per setting.
+#ifndef MEMCOPY_MAX_BURST
+#define MEMCOPY_MAX_BURST 16        // beats per AXI burst (max_read/write_burst_length)
+#endif
+#ifndef MEMCOPY_NUM_OUTSTANDING
+#define MEMCOPY_NUM_OUTSTANDING 16  // in-flight bursts (num_read/write_outstanding)
+#endif
+#ifndef MEMCOPY_AXI_DEPTH
+#define MEMCOPY_AXI_DEPTH 16384     // cosim depth of src/dst, must cover the testbench buffers
+#endif
+
+// Block-level protocol of memcopy_accel. With ap_ctrl_chain (default) the
+// arguments are latched on ap_ready, the driver may queue the next job with
+// ap_start while the current one drains, and each ap_done is held until the
+// driver acknowledges it with ap_continue (AP_CTRL bit 4). Build with
+// -DMEMCOPY_CTRL_CHAIN=0 for the plain ap_ctrl_hs handshake.
+#ifndef MEMCOPY_CTRL_CHAIN
+#define MEMCOPY_CTRL_CHAIN 1
+#endif
+
+template <int W>
+struct memcopy_bus {
+    typedef ap_uint<W> beat_t;
+    static const int BYTES = W / 8;
+    // Keep the same 128-byte burst as the 32-bit kernel
+    static const int BURST_BEATS = (BURST_LEN * 4) / BYTES;
+};
+
+typedef memcopy_bus<MEMCOPY_BUS_WIDTH>::beat_t memcopy_beat_t;
+
+// Byte lengths and byte positions of the byte-exact kernel: 64-bit, so a
+// single job may move more than 4 GiB on the 64-bit MPSoC address map
+typedef uint64_t memcopy_len_t;
+
+// Top functions (select one with set_top).
+// memcopy_accel is the byte-exact kernel driven by the bare-metal driver;
+// memcopy_accel_word is the original 32-bit kernel, kept as the reference.
+void memcopy_accel(memcopy_beat_t* src, memcopy_beat_t* dst, uint64_t len,
+                   uint32_t src_off, uint32_t dst_off, uint8_t* dst_bytes,
+                   uint32_t op, memcopy_beat_t* desc,
+                   uint32_t rows, uint32_t row_bytes, uint32_t src_stride, uint32_t dst_stride,
+                   uint32_t fill, uint32_t* crc,
+                   uint32_t* cmp_match, uint64_t* cmp_first, uint64_t* cmp_count,
+                   uint32_t* perf_cycles, uint32_t* perf_rd_beats, uint32_t* perf_wr_beats,
+                   uint32_t* perf_stall,
+                   memcopy_beat_t* cpl, volatile uint32_t* ring_prod,
+                   uint32_t irq_count, uint32_t irq_idle);
+void memcopy_accel_word(uint32_t* src, uint32_t* dst, uint32_t len);
+void memcopy_accel_wide(memcopy_beat_t* src, memcopy_beat_t* dst, uint32_t len);
+void memcopy_accel_dataflow(memcopy_beat_t* src, memcopy_beat_t* dst, uint32_t len);
+
+// Operation codes (op register)
+#define MEMCOPY_OP_COPY     0   // single copy: src/dst/len/src_off/dst_off
+#define MEMCOPY_OP_SG       1   // descriptor chain: desc table, len = descriptor count
+#define MEMCOPY_OP_2D       2   // rectangle: rows x row_bytes, src_stride/dst_stride pitch
+#define MEMCOPY_OP_FILL     3   // write-only: every 32-bit word = fill
+#define MEMCOPY_OP_PATTERN  4   // write-only: 32-bit word i = fill + i
+#define MEMCOPY_OP_CMP      5   // read-only: compare len bytes at src/src_off and dst/dst_off
+#define MEMCOPY_OP_SWAP16   6   // copy, reversing the bytes of each 16-bit element
+#define MEMCOPY_OP_SWAP32   7   // copy, reversing the bytes of each 32-bit element
+#define MEMCOPY_OP_SWAP64   8   // copy, reversing the bytes of each 64-bit element
+#define MEMCOPY_OP_WIDEN16  9   // u8 -> u16: writes 2 * len bytes
+#define MEMCOPY_OP_WIDEN32  10  // u8 -> u32: writes 4 * len bytes
+#define MEMCOPY_OP_RING     11  // command ring: desc = slots, len = slot count, cpl = completions
+
+// Scatter-gather descriptor, 32 bytes, little-endian in DDR:
+//   [63:0] src   [127:64] dst   [159:128] len   [191:160] flags   [255:192] reserved
+// len is 32 bits per descriptor; a chain may add up to more than 4 GiB.
+// src/dst are byte addresses relative to the src/dst registers (the driver
+// programs those to 0, so descriptors hold absolute addresses).
+#define MEMCOPY_DESC_BYTES  32
+#define MEMCOPY_DESC_LAST   0x1u  // stop after this descriptor
+#define MEMCOPY_DESC_STOP   0x2u  // command ring: return and stay idle after this command
+
+// Depth of the FIFO between the read and write stages (two max-size bursts)
+#define MEMCOPY_FIFO_DEPTH 64
+
+// Wide-bus copy core.
+// Same contract as memcopy_accel_word: len is in bytes and is rounded down to a
+// multiple of 4, so both kernels write exactly the same destination bytes.
+// src and dst must be aligned to the bus width (W/8 bytes).
+// BURST is the number of beats buffered per read/write chunk.
+template <int W, int BURST = memcopy_bus<W>::BURST_BEATS>
+void memcopy_wide(const ap_uint<W>* src, ap_uint<W>* dst, uint32_t len) {
+    const int BYTES = memcopy_bus<W>::BYTES;
+
+    uint32_t num_bytes = len & ~3u;
+    uint32_t num_beats = num_bytes / BYTES;   // full bus beats
+    uint32_t tail_bytes = num_bytes % BYTES;  // 4, 8 or 12 bytes left over
+    ap_uint<W> buffer[BURST];
+
+wide_copy_loop:
+    for (uint32_t i = 0; i < num_beats; i += BURST) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=1024
+        uint32_t chunk = (i + BURST <= num_beats) ? (uint32_t)BURST : (num_beats - i);
+
+    wide_read_loop:
+        for (uint32_t j = 0; j < chunk; j++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=16
+            buffer[j] = src[i + j];
+        }
+    wide_write_loop:
+        for (uint32_t j = 0; j < chunk; j++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=16
+            dst[i + j] = buffer[j];
+        }
+    }
+
+    // Partial last beat: merge the remaining words into the existing
+    // destination beat so bytes past len are left untouched.
+    if (tail_bytes != 0) {
+        ap_uint<W> s = src[num_beats];
+        ap_uint<W> d = dst[num_beats];
+        ap_uint<W> keep = ~ap_uint<W>(0);
+        keep = keep << (tail_bytes * 8);
+        dst[num_beats] = (s & ~keep) | (d & keep);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Dataflow copy: a read stage and a write stage connected by a FIFO, so
+// AXI_SRC and AXI_DST transfer at the same time instead of alternating
+// read-burst / write-burst as in memcopy_wide.
+// ---------------------------------------------------------------------------
+template <int W>
+void memcopy_read_stage(const ap_uint<W>* src, hls::stream<ap_uint<W> >& fifo, uint32_t len) {
+    const int BYTES = memcopy_bus<W>::BYTES;
+    uint32_t num_bytes = len & ~3u;
+    uint32_t num_beats = (num_bytes + BYTES - 1) / BYTES;  // including partial last beat
+
+read_stage_loop:
+    for (uint32_t i = 0; i < num_beats; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=4096
+        fifo.write(src[i]);
+    }
+}
+
+template <int W>
+void memcopy_write_stage(hls::stream<ap_uint<W> >& fifo, ap_uint<W>* dst, uint32_t len) {
+    const int BYTES = memcopy_bus<W>::BYTES;
+    uint32_t num_bytes = len & ~3u;
+    uint32_t num_beats = num_bytes / BYTES;
+    uint32_t tail_bytes = num_bytes % BYTES;
+
+write_stage_loop:
+    for (uint32_t i = 0; i < num_beats; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=4096
+        dst[i] = fifo.read();
+    }
+
+    // Partial last beat, merged as in memcopy_wide
+    if (tail_bytes != 0) {
+        ap_uint<W> s = fifo.read();
+        ap_uint<W> d = dst[num_beats];
+        ap_uint<W> keep = ~ap_uint<W>(0);
+        keep = keep << (tail_bytes * 8);
+        dst[num_beats] = (s & ~keep) | (d & keep);
+    }
+}
+
+template <int W>
+void memcopy_dataflow(const ap_uint<W>* src, ap_uint<W>* dst, uint32_t len) {
+#pragma HLS DATAFLOW
+    hls::stream<ap_uint<W> > fifo("copy_fifo");
+#pragma HLS STREAM variable=fifo depth=MEMCOPY_FIFO_DEPTH
+
+    memcopy_read_stage<W>(src, fifo, len);
+    memcopy_write_stage<W>(fifo, dst, len);
+}
+
+// ---------------------------------------------------------------------------
+// Byte-exact copy for any length and any src/dst byte alignment.
+// src/dst are the bus-aligned bases, src_off/dst_off (< W/8) the byte
+// offsets of the first byte. The source beats are realigned to the
+// destination with a funnel shifter; the aligned middle is written as full
+// beats at burst rate, and the partial head/tail beats are written through
+// the byte view dst_bytes so only the covered byte lanes are strobed.
+// ---------------------------------------------------------------------------
+template <int W>
+void memcopy_read_unaligned(const ap_uint<W>* src, hls::stream<ap_uint<W> >& fifo,
+                            memcopy_len_t len, uint32_t src_off) {
+    const int BYTES = memcopy_bus<W>::BYTES;
+    memcopy_len_t num_beats = (len == 0) ? 0 : (src_off + len + BYTES - 1) / BYTES;
+
+read_unaligned_loop:
+    for (memcopy_len_t i = 0; i < num_beats; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=4096
+        fifo.write(src[i]);
+    }
+}
+
+template <int W>
+void memcopy_realign_stage(hls::stream<ap_uint<W> >& in, hls::stream<ap_uint<W> >& out,
+                           memcopy_len_t len, uint32_t src_off, uint32_t dst_off) {
+    const int BYTES = memcopy_bus<W>::BYTES;
+    memcopy_len_t num_in = (len == 0) ? 0 : (src_off + len + BYTES - 1) / BYTES;
+    memcopy_len_t num_out = (len == 0) ? 0 : (dst_off + len + BYTES - 1) / BYTES;
+
+    // Output beat k is bytes [shift, shift + BYTES) of {S[k+1], S[k]} when the
+    // source is ahead of the destination, and of {S[k], S[k-1]} otherwise.
+    bool src_ahead = (src_off >= dst_off);
+    uint32_t shift = src_ahead ? (src_off - dst_off) : (src_off + BYTES - dst_off);
+    ap_uint<W> prev = 0;
+    memcopy_len_t num_read = 0;
+
+    if (src_ahead && num_in != 0) {
+        prev = in.read();
+        num_read = 1;
+    }
+
+realign_loop:
+    for (memcopy_len_t k = 0; k < num_out; k++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=4096
+        ap_uint<W> cur = 0;
+        if (num_read < num_in) {
+            cur = in.read();
+            num_read++;
+        }
+        ap_uint<2 * W> window = (ap_uint<2 * W>(cur) << W) | ap_uint<2 * W>(prev);
+        out.write(ap_uint<W>(window >> (shift * 8)));
+        prev = cur;
+    }
+}
+
+// CRC-32 (IEEE 802.3, reflected, poly 0xEDB88320) of the bytes written.
+// The running value starts at MEMCOPY_CRC_INIT and is carried across SG
+// descriptors and 2D rows; the top complements it into the crc register.
+#define MEMCOPY_CRC_INIT 0xFFFFFFFFu
+
+inline uint32_t memcopy_crc32_byte(uint32_t crc, uint8_t b) {
+#pragma HLS INLINE
+    crc ^= b;
+    for (int k = 0; k < 8; k++) {
+#pragma HLS UNROLL
+        crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return crc;
+}
+
+// Fold bytes [lo, hi) of a beat into the CRC
+template <int W>
+uint32_t memcopy_crc32_beat(uint32_t crc, const ap_uint<W>& beat, uint32_t lo, uint32_t hi) {
+#pragma HLS INLINE
+    const int BYTES = memcopy_bus<W>::BYTES;
+    for (int b = 0; b < BYTES; b++) {
+#pragma HLS UNROLL
+        if ((uint32_t)b >= lo && (uint32_t)b < hi)
+            crc = memcopy_crc32_byte(crc, (uint8_t)beat.range(8 * b + 7, 8 * b).to_uint());
+    }
+    return crc;
+}
+
+template <int W>
+void memcopy_write_bytes(const ap_uint<W>& beat, uint8_t* dst_bytes, memcopy_len_t beat_idx,
+                         uint32_t lo, uint32_t hi) {
+    const int BYTES = memcopy_bus<W>::BYTES;
+
+write_bytes_loop:
+    for (uint32_t b = 0; b < BYTES; b++) {
+#pragma HLS PIPELINE II=1
+        if (b >= lo && b < hi)
+            dst_bytes[beat_idx * BYTES + b] = (uint8_t)beat.range(8 * b + 7, 8 * b).to_uint();
+    }
+}
+
+template <int W>
+void memcopy_strobe_write_stage(hls::stream<ap_uint<W> >& fifo, ap_uint<W>* dst, uint8_t* dst_bytes,
+                                memcopy_len_t len, uint32_t dst_off, uint32_t crc_in, uint32_t& crc_out) {
+    const int BYTES = memcopy_bus<W>::BYTES;
+    uint32_t crc = crc_in;
+    memcopy_len_t end = dst_off + len;             // end offset from the aligned base
+    memcopy_len_t num_beats = (len == 0) ? 0 : (end + BYTES - 1) / BYTES;
+    uint32_t tail_bytes = end % BYTES;             // valid bytes in the last beat, 0 = full
+
+    bool head_partial = (num_beats != 0) && (dst_off != 0 || (num_beats == 1 && tail_bytes != 0));
+    bool tail_partial = (num_beats > 1) && (tail_bytes != 0);
+    memcopy_len_t mid_begin = head_partial ? 1 : 0;
+    memcopy_len_t mid_end = tail_partial ? num_beats - 1 : num_beats;
+
+    if (head_partial) {
+        uint32_t hi = (num_beats == 1 && tail_bytes != 0) ? tail_bytes : (uint32_t)BYTES;
+        ap_uint<W> beat = fifo.read();
+        memcopy_write_bytes<W>(beat, dst_bytes, 0, dst_off, hi);
+        crc = memcopy_crc32_beat<W>(crc, beat, dst_off, hi);
+    }
+
+strobe_write_loop:
+    for (memcopy_len_t i = mid_begin; i < mid_end; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=4096
+        ap_uint<W> beat = fifo.read();
+        dst[i] = beat;
+        crc = memcopy_crc32_beat<W>(crc, beat, 0, BYTES);
+    }
+
+    if (tail_partial) {
+        ap_uint<W> beat = fifo.read();
+        memcopy_write_bytes<W>(beat, dst_bytes, num_beats - 1, 0, tail_bytes);
+        crc = memcopy_crc32_beat<W>(crc, beat, 0, tail_bytes);
+    }
+    crc_out = crc;
+}
+
+template <int W>
+void memcopy_unaligned(const ap_uint<W>* src, ap_uint<W>* dst, uint8_t* dst_bytes,
+                       memcopy_len_t len, uint32_t src_off, uint32_t dst_off,
+                       uint32_t crc_in, uint32_t& crc_out) {
+#pragma HLS DATAFLOW
+    hls::stream<ap_uint<W> > in_fifo("src_fifo");
+    hls::stream<ap_uint<W> > out_fifo("dst_fifo");
+#pragma HLS STREAM variable=in_fifo depth=MEMCOPY_FIFO_DEPTH
+#pragma HLS STREAM variable=out_fifo depth=MEMCOPY_FIFO_DEPTH
+
+    memcopy_read_unaligned<W>(src, in_fifo, len, src_off);
+    memcopy_realign_stage<W>(in_fifo, out_fifo, len, src_off, dst_off);
+    memcopy_strobe_write_stage<W>(out_fifo, dst, dst_bytes, len, dst_off, crc_in, crc_out);
+}
+
+// ---------------------------------------------------------------------------
+// Performance counters (perf_* registers), per invocation.
+// Beat counts are AXI data beats: a byte-exact transfer moves its full
+// beats at bus width and each byte of a partial head/tail beat as one
+// single-byte strobe write. The cycle counter runs next to the operation in
+// a top-level DATAFLOW region and counts from ap_start until the operation
+// has finished; stall cycles are the cycles beyond one beat per cycle on the
+// busier master. Cycles and stalls are only meaningful in RTL / cosim
+// (csim executes the processes one after the other and reports 0). The
+// registers are 32 bits and wrap on runs of more than 2^32 beats.
+// ---------------------------------------------------------------------------
+struct memcopy_perf_t {
+    uint32_t rd_beats;
+    uint32_t wr_beats;
+};
+
+template <int W>
+memcopy_len_t memcopy_read_beats(uint32_t off, memcopy_len_t len) {
+#pragma HLS INLINE
+    const int BYTES = memcopy_bus<W>::BYTES;
+    return (len == 0) ? 0 : (off + len + BYTES - 1) / BYTES;
+}
+
+// Mirrors the head/middle/tail split of memcopy_strobe_write_stage
+template <int W>
+memcopy_len_t memcopy_write_beats(uint32_t off, memcopy_len_t len) {
+#pragma HLS INLINE
+    const int BYTES = memcopy_bus<W>::BYTES;
+    memcopy_len_t end = off + len;
+    memcopy_len_t num_beats = (len == 0) ? 0 : (end + BYTES - 1) / BYTES;
+    uint32_t tail_bytes = end % BYTES;
+    bool head_partial = (num_beats != 0) && (off != 0 || (num_beats == 1 && tail_bytes != 0));
+    bool tail_partial = (num_beats > 1) && (tail_bytes != 0);
+
+    memcopy_len_t n = num_beats - (head_partial ? 1 : 0) - (tail_partial ? 1 : 0);
+    if (head_partial)
+        n += ((num_beats == 1 && tail_bytes != 0) ? tail_bytes : (uint32_t)BYTES) - off;
+    if (tail_partial)
+        n += tail_bytes;
+    return n;
+}
+
+// Spins one iteration per clock until the operation posts its beat counts
+inline void memcopy_cycle_counter(hls::stream<memcopy_perf_t>& done, uint32_t* cycles,
+                                  uint32_t* rd_beats, uint32_t* wr_beats, uint32_t* stall) {
+    uint32_t n = 0;
+    memcopy_perf_t p;
+
+cycle_count_loop:
+    while (!done.read_nb(p)) {
+#pragma HLS PIPELINE II=1
+        n++;
+    }
+    uint32_t busy = (p.rd_beats > p.wr_beats) ? p.rd_beats : p.wr_beats;
+    *cycles = n;
+    *rd_beats = p.rd_beats;
+    *wr_beats = p.wr_beats;
+    *stall = (n > busy) ? n - busy : 0;
+}
+
+// ---------------------------------------------------------------------------
+// Scatter-gather: execute up to num_desc descriptors back to back. ap_done
+// (and so the interrupt) is raised once, after the whole chain.
+// ---------------------------------------------------------------------------
+template <int W>
+void memcopy_sg(const ap_uint<W>* desc, const ap_uint<W>* src, ap_uint<W>* dst, uint8_t* dst_bytes,
+                uint32_t num_desc, uint32_t& crc, memcopy_perf_t& perf) {
+    const int BYTES = memcopy_bus<W>::BYTES;
+    const int DESC_BEATS = MEMCOPY_DESC_BYTES / BYTES;
+
+sg_loop:
+    for (uint32_t i = 0; i < num_desc; i++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64
+        ap_uint<8 * MEMCOPY_DESC_BYTES> d = 0;
+    sg_fetch_loop:
+        for (int b = 0; b < DESC_BEATS; b++) {
+#pragma HLS PIPELINE II=1
+            d |= ap_uint<8 * MEMCOPY_DESC_BYTES>(desc[i * DESC_BEATS + b]) << (b * W);
+        }
+
+        uint64_t d_src = d.range(63, 0).to_uint64();
+        uint64_t d_dst = d.range(127, 64).to_uint64();
+        uint32_t d_len = d.range(159, 128).to_uint();
+        uint32_t d_flags = d.range(191, 160).to_uint();
+        uint32_t src_off = d_src % BYTES;
+        uint32_t dst_off = d_dst % BYTES;
+
+        memcopy_unaligned<W>(src + d_src / BYTES, dst + d_dst / BYTES,
+                             dst_bytes + (d_dst - dst_off), d_len, src_off, dst_off, crc, crc);
+        perf.rd_beats += DESC_BEATS + memcopy_read_beats<W>(src_off, d_len);
+        perf.wr_beats += memcopy_write_beats<W>(dst_off, d_len);
+
+        if (d_flags & MEMCOPY_DESC_LAST)
+            break;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 2D strided copy: rows x row_bytes, row r starting at src_off + r*src_stride
+// and dst_off + r*dst_stride bytes from the src/dst bases. Each row is one
+// byte-exact copy, so the rows are burst-read/written and any pitch works.
+// ---------------------------------------------------------------------------
+template <int W>
+void memcopy_2d(const ap_uint<W>* src, ap_uint<W>* dst, uint8_t* dst_bytes,
+                uint32_t src_off, uint32_t dst_off, uint32_t rows, uint32_t row_bytes,
+                uint32_t src_stride, uint32_t dst_stride, uint32_t& crc, memcopy_perf_t& perf) {
+    const int BYTES = memcopy_bus<W>::BYTES;
+    memcopy_len_t s = src_off;      // rows * stride may pass 4 GiB
+    memcopy_len_t d = dst_off;
+
+rows_loop:
+    for (uint32_t r = 0; r < rows; r++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=1080
+        memcopy_len_t d_base = d - d % BYTES;
+        memcopy_unaligned<W>(src + s / BYTES, dst + d / BYTES, dst_bytes + d_base,
+                             row_bytes, s % BYTES, d % BYTES, crc, crc);
+        perf.rd_beats += memcopy_read_beats<W>(s % BYTES, row_bytes);
+        perf.wr_beats += memcopy_write_beats<W>(d % BYTES, row_bytes);
+        s += src_stride;
+        d += dst_stride;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Fill / pattern generation: write-only, no AXI_SRC traffic. The generator
+// builds beats as if the region started on a bus boundary; the realign and
+// strobe-write stages of the byte-exact copy then place them at dst_off.
+// Word i (32-bit, counted from the first byte) is fill, or fill + i when
+// incr is set, so a pattern fill reproduces e.g. 0xA5A50000 | i.
+// ---------------------------------------------------------------------------
+template <int W>
+void memcopy_fill_gen_stage(hls::stream<ap_uint<W> >& fifo, memcopy_len_t len, uint32_t fill, bool incr) {
+    const int BYTES = memcopy_bus<W>::BYTES;
+    const int WORDS = BYTES / 4;
+    memcopy_len_t num_beats = (len + BYTES - 1) / BYTES;
+    uint32_t word = fill;
+    uint32_t step = incr ? 1 : 0;
+
+fill_gen_loop:
+    for (memcopy_len_t i = 0; i < num_beats; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=4096
+        ap_uint<W> beat;
+        for (int j = 0; j < WORDS; j++) {
+#pragma HLS UNROLL
+            beat.range(32 * j + 31, 32 * j) = word + j * step;
+        }
+        word += WORDS * step;
+        fifo.write(beat);
+    }
+}
+
+template <int W>
+void memcopy_fill(ap_uint<W>* dst, uint8_t* dst_bytes, memcopy_len_t len, uint32_t dst_off,
+                  uint32_t fill, bool incr, uint32_t& crc) {
+#pragma HLS DATAFLOW
+    hls::stream<ap_uint<W> > gen_fifo("gen_fifo");
+    hls::stream<ap_uint<W> > out_fifo("dst_fifo");
+#pragma HLS STREAM variable=gen_fifo depth=MEMCOPY_FIFO_DEPTH
+#pragma HLS STREAM variable=out_fifo depth=MEMCOPY_FIFO_DEPTH
+
+    memcopy_fill_gen_stage<W>(gen_fifo, len, fill, incr);
+    memcopy_realign_stage<W>(gen_fifo, out_fifo, len, 0, dst_off);
+    memcopy_strobe_write_stage<W>(out_fifo, dst, dst_bytes, len, dst_off, MEMCOPY_CRC_INIT, crc);
+}
+
+// ---------------------------------------------------------------------------
+// Compare (memcmp): src is read and realigned exactly as for a copy, dst is
+// read over AXI_DST in step, and each byte in [dst_off, dst_off + len) is
+// compared. Nothing is written. first is the byte offset (from the start of
+// the compared range) of the first difference, MEMCOPY_CMP_NONE if equal;
+// count is the number of differing bytes.
+// ---------------------------------------------------------------------------
+#define MEMCOPY_CMP_NONE 0xFFFFFFFFFFFFFFFFull
+
+template <int W>
+void memcopy_compare_stage(hls::stream<ap_uint<W> >& fifo, const ap_uint<W>* dst,
+                           memcopy_len_t len, uint32_t dst_off, memcopy_len_t& first, memcopy_len_t& count) {
+    const int BYTES = memcopy_bus<W>::BYTES;
+    memcopy_len_t end = dst_off + len;
+    memcopy_len_t num_beats = (len == 0) ? 0 : (end + BYTES - 1) / BYTES;
+    memcopy_len_t f = MEMCOPY_CMP_NONE;
+    memcopy_len_t n = 0;
+
+compare_loop:
+    for (memcopy_len_t i = 0; i < num_beats; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=4096
+        ap_uint<W> a = fifo.read();
+        ap_uint<W> b = dst[i];
+        memcopy_len_t base = i * BYTES;
+        uint32_t beat_n = 0;
+        memcopy_len_t beat_f = MEMCOPY_CMP_NONE;
+        for (int k = BYTES - 1; k >= 0; k--) {
+#pragma HLS UNROLL
+            memcopy_len_t pos = base + k;
+            bool diff = pos >= dst_off && pos < end && a.range(8 * k + 7, 8 * k) != b.range(8 * k + 7, 8 * k);
+            if (diff) {
+                beat_n++;
+                beat_f = pos - dst_off;   // lowest differing lane wins
+            }
+        }
+        if (f == MEMCOPY_CMP_NONE)
+            f = beat_f;
+        n += beat_n;
+    }
+    first = f;
+    count = n;
+}
+
+template <int W>
+void memcopy_compare(const ap_uint<W>* src, const ap_uint<W>* dst, memcopy_len_t len,
+                     uint32_t src_off, uint32_t dst_off, memcopy_len_t& first, memcopy_len_t& count) {
+#pragma HLS DATAFLOW
+    hls::stream<ap_uint<W> > in_fifo("src_fifo");
+    hls::stream<ap_uint<W> > cmp_fifo("cmp_fifo");
+#pragma HLS STREAM variable=in_fifo depth=MEMCOPY_FIFO_DEPTH
+#pragma HLS STREAM variable=cmp_fifo depth=MEMCOPY_FIFO_DEPTH
+
+    memcopy_read_unaligned<W>(src, in_fifo, len, src_off);
+    memcopy_realign_stage<W>(in_fifo, cmp_fifo, len, src_off, dst_off);
+    memcopy_compare_stage<W>(cmp_fifo, dst, len, dst_off, first, count);
+}
+
+// ---------------------------------------------------------------------------
+// Transforming copy: byte swap of 16/32/64-bit elements, or zero-extension
+// of u8 to u16/u32. Elements are counted from the first source byte, so the
+// source is realigned to offset 0, transformed, then realigned to dst_off:
+//   read -> realign(src_off, 0) -> transform -> realign(0, dst_off) -> write
+// Every stage runs at II=1 per beat, so widening reads at 1/2 or 1/4 of the
+// write rate and the write bursts stay full. A trailing partial element of
+// a swap is copied unchanged. len is the source length; a widen writes
+// len * 2 or len * 4 bytes.
+// ---------------------------------------------------------------------------
+inline uint32_t memcopy_widen_factor(uint32_t op) {
+#pragma HLS INLINE
+    return (op == MEMCOPY_OP_WIDEN16) ? 2 : (op == MEMCOPY_OP_WIDEN32) ? 4 : 1;
+}
+
+// Reverse the bytes of each complete E-byte element; valid = source bytes
+// in this beat (BYTES for a full beat)
+template <int W, int E>
+ap_uint<W> memcopy_swap_beat(const ap_uint<W>& beat, uint32_t valid) {
+#pragma HLS INLINE
+    const int BYTES = memcopy_bus<W>::BYTES;
+    ap_uint<W> o = beat;
+    for (int e = 0; e < BYTES / E; e++) {
+#pragma HLS UNROLL
+        if ((uint32_t)((e + 1) * E) <= valid) {
+            for (int b = 0; b < E; b++) {
+#pragma HLS UNROLL
+                int from = e * E + b, to = e * E + (E - 1 - b);
+                o.range(8 * to + 7, 8 * to) = beat.range(8 * from + 7, 8 * from);
+            }
+        }
+    }
+    return o;
+}
+
+// Output beat `part` of K produced from one input beat: bytes
+// [part * BYTES/K, (part + 1) * BYTES/K) zero-extended to K bytes each
+template <int W, int K>
+ap_uint<W> memcopy_widen_beat(const ap_uint<W>& beat, uint32_t part) {
+#pragma HLS INLINE
+    const int BYTES = memcopy_bus<W>::BYTES;
+    ap_uint<W> in = beat >> (part * (W / K));
+    ap_uint<W> o = 0;
+    for (int b = 0; b < BYTES / K; b++) {
+#pragma HLS UNROLL
+        o.range(8 * K * b + 7, 8 * K * b) = in.range(8 * b + 7, 8 * b);
+    }
+    return o;
+}
+
+template <int W>
+void memcopy_transform_stage(hls::stream<ap_uint<W> >& in, hls::stream<ap_uint<W> >& out,
+                             memcopy_len_t len, uint32_t op) {
+    const int BYTES = memcopy_bus<W>::BYTES;
+    uint32_t widen = memcopy_widen_factor(op);
+    memcopy_len_t num_out = (len * widen + BYTES - 1) / BYTES;
+    ap_uint<W> cur = 0;
+
+transform_loop:
+    for (memcopy_len_t j = 0; j < num_out; j++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=4096
+        uint32_t part = j & (widen - 1);
+        memcopy_len_t in_idx = j / widen;
+        if (part == 0)
+            cur = in.read();
+        memcopy_len_t left = len - in_idx * BYTES;
+        uint32_t valid = (left > (memcopy_len_t)BYTES) ? (uint32_t)BYTES : (uint32_t)left;
+
+        ap_uint<W> o;
+        switch (op) {
+        case MEMCOPY_OP_SWAP16:  o = memcopy_swap_beat<W, 2>(cur, valid); break;
+        case MEMCOPY_OP_SWAP32:  o = memcopy_swap_beat<W, 4>(cur, valid); break;
+        case MEMCOPY_OP_SWAP64:  o = memcopy_swap_beat<W, 8>(cur, valid); break;
+        case MEMCOPY_OP_WIDEN16: o = memcopy_widen_beat<W, 2>(cur, part); break;
+        case MEMCOPY_OP_WIDEN32: o = memcopy_widen_beat<W, 4>(cur, part); break;
+        default:                 o = cur; break;
+        }
+        out.write(o);
+    }
+}
+
+template <int W>
+void memcopy_transform(const ap_uint<W>* src, ap_uint<W>* dst, uint8_t* dst_bytes,
+                       memcopy_len_t len, uint32_t src_off, uint32_t dst_off, uint32_t op,
+                       uint32_t& crc) {
+#pragma HLS DATAFLOW
+    hls::stream<ap_uint<W> > in_fifo("src_fifo");
+    hls::stream<ap_uint<W> > elem_fifo("elem_fifo");
+    hls::stream<ap_uint<W> > xform_fifo("xform_fifo");
+    hls::stream<ap_uint<W> > out_fifo("dst_fifo");
+#pragma HLS STREAM variable=in_fifo depth=MEMCOPY_FIFO_DEPTH
+#pragma HLS STREAM variable=elem_fifo depth=MEMCOPY_FIFO_DEPTH
+#pragma HLS STREAM variable=xform_fifo depth=MEMCOPY_FIFO_DEPTH
+#pragma HLS STREAM variable=out_fifo depth=MEMCOPY_FIFO_DEPTH
+
+    memcopy_len_t out_len = len * memcopy_widen_factor(op);
+
+    memcopy_read_unaligned<W>(src, in_fifo, len, src_off);
+    memcopy_realign_stage<W>(in_fifo, elem_fifo, len, src_off, 0);
+    memcopy_transform_stage<W>(elem_fifo, xform_fifo, len, op);
+    memcopy_realign_stage<W>(xform_fifo, out_fifo, out_len, 0, dst_off);
+    memcopy_strobe_write_stage<W>(out_fifo, dst, dst_bytes, out_len, dst_off, MEMCOPY_CRC_INIT, crc);
+}
+
+// ---------------------------------------------------------------------------
+// Command ring (MEMCOPY_OP_RING). Software owns a ring of `slots` commands
+// (power of two, descriptor format, bits [255:192] = cookie) and a 32-bit
+// producer index in DDR; it enqueues with plain memory writes. The kernel
+// polls the producer index, runs each command as a byte-exact copy and
+// writes a MEMCOPY_DESC_BYTES completion entry per command:
+//   [63:0] cookie   [95:64] status   [127:96] CRC-32   [159:128] len
+//   [191:160] seq (command index + 1, so a zeroed ring reads as empty)
+// Completion entry i is at cpl + (1 + i % slots) entries; entry 0 is the
+// header holding the consumer index, which carries the ring position over
+// to the next run. A run returns (ap_done, so one interrupt) after
+// irq_count completions, after irq_idle polls of an empty ring with
+// completions pending, or after a MEMCOPY_DESC_STOP command. With
+// auto_restart the IP resumes polling as soon as the interrupt is
+// acknowledged. A run never returns while the ring is empty and nothing is
+// pending, except on a stopped ring: the run that executes the stop command
+// was started with auto_restart still set, so ap_start is already high for
+// one more run. That run finds the ring empty with the stop command's
+// completion as the last entry and returns at once, without completions.
+// Commands added after a stop are run as usual.
+// ---------------------------------------------------------------------------
+#define MEMCOPY_CPL_DONE    0x1u  // status: command executed
+#define MEMCOPY_CPL_STOP    0x2u  // status: it was the MEMCOPY_DESC_STOP command
+
+template <int W>
+void memcopy_ring(const ap_uint<W>* ring, const ap_uint<W>* src, ap_uint<W>* dst, uint8_t* dst_bytes,
+                  ap_uint<W>* cpl, volatile uint32_t* ring_prod, uint32_t slots,
+                  uint32_t irq_count, uint32_t irq_idle, uint32_t& crc, memcopy_perf_t& perf) {
+    const int BYTES = memcopy_bus<W>::BYTES;
+    const int DESC_BEATS = MEMCOPY_DESC_BYTES / BYTES;
+    uint32_t cons = cpl[0].range(31, 0).to_uint();
+    uint32_t pending = 0, idle = 0;
+    bool stop = false;
+    perf.rd_beats += 1;
+
+    // Stopped and empty: the run after the stop command's run
+    if (cons != 0 && *ring_prod == cons) {
+        ap_uint<W> status_beat = cpl[(1 + ((cons - 1) & (slots - 1))) * DESC_BEATS + 64 / W];
+        stop = (status_beat.range(64 % W + 31, 64 % W).to_uint() & MEMCOPY_CPL_STOP) != 0;
+        perf.rd_beats += 2;
+    }
+
+ring_loop:
+    while (!stop) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64
+        uint32_t prod = *ring_prod;
+        perf.rd_beats += 1;
+        if (prod == cons) {
+            if (pending != 0 && ++idle >= irq_idle)
+                break;
+            continue;
+        }
+        idle = 0;
+
+        uint32_t slot = cons & (slots - 1);
+        ap_uint<8 * MEMCOPY_DESC_BYTES> d = 0;
+    ring_fetch_loop:
+        for (int b = 0; b < DESC_BEATS; b++) {
+#pragma HLS PIPELINE II=1
+            d |= ap_uint<8 * MEMCOPY_DESC_BYTES>(ring[slot * DESC_BEATS + b]) << (b * W);
+        }
+
+        uint64_t d_src = d.range(63, 0).to_uint64();
+        uint64_t d_dst = d.range(127, 64).to_uint64();
+        uint32_t d_len = d.range(159, 128).to_uint();
+        uint32_t d_flags = d.range(191, 160).to_uint();
+        uint32_t src_off = d_src % BYTES;
+        uint32_t dst_off = d_dst % BYTES;
+        uint32_t state = MEMCOPY_CRC_INIT;
+
+        memcopy_unaligned<W>(src + d_src / BYTES, dst + d_dst / BYTES,
+                             dst_bytes + (d_dst - dst_off), d_len, src_off, dst_off, state, state);
+        stop = (d_flags & MEMCOPY_DESC_STOP) != 0;
+        crc = ~state;
+
+        ap_uint<8 * MEMCOPY_DESC_BYTES> c = 0;
+        c.range(63, 0) = d.range(255, 192);
+        c.range(95, 64) = MEMCOPY_CPL_DONE | (stop ? MEMCOPY_CPL_STOP : 0u);
+        c.range(127, 96) = crc;
+        c.range(159, 128) = d_len;
+        c.range(191, 160) = cons + 1;
+    ring_cpl_loop:
+        for (int b = 0; b < DESC_BEATS; b++) {
+#pragma HLS PIPELINE II=1
+            cpl[(1 + slot) * DESC_BEATS + b] = ap_uint<W>(c >> (b * W));
+        }
+        cons++;
+        cpl[0] = cons;
+
+        perf.rd_beats += DESC_BEATS + memcopy_read_beats<W>(src_off, d_len);
+        perf.wr_beats += DESC_BEATS + 1 + memcopy_write_beats<W>(dst_off, d_len);
+        if (++pending >= irq_count)
+            break;
+    }
+}
@@ -3,3 +3,68 @@
 
 // Optional external test data file (if needed later)
 // For now, it's empty. You can define static arrays here for complex tests.
+
+// Buffer size used by the wide-bus comparison tests
+#define TB_MAX_WORDS    1024
+#define TB_MAX_BYTES    (TB_MAX_WORDS * 4)
+#define TB_GUARD_WORD   0xDEADBEEFu
+
+// Byte lengths for the wide-bus tests. Most are multiples of 4 but not of
+// 8 or 16, so the partial last beat is exercised; a few are not even
+// multiples of 4 to check the kernels drop the same tail bytes.
+static const uint32_t tb_wide_lens[] = {
+    0, 4, 8, 12, 16, 20, 28, 36, 60, 124, 128, 132, 252, 260,
+    516, 1020, 2052, 4092, 4096, 5, 13, 127,
+};
+#define TB_NUM_WIDE_LENS ((int)(sizeof(tb_wide_lens) / sizeof(tb_wide_lens[0])))
+
+// Byte lengths for the byte-exact kernel, each run with every src/dst
+// offset: empty, single byte, within one beat, straddling two beats and
+// long enough for a burst-rate middle.
+static const uint32_t tb_unaligned_lens[] = {
+    0, 1, 2, 3, 5, 7, 8, 9, 15, 16, 17, 31, 33, 63, 64, 65, 127, 255, 1000, 1501,
+};
+#define TB_NUM_UNALIGNED_LENS ((int)(sizeof(tb_unaligned_lens) / sizeof(tb_unaligned_lens[0])))
+
+// Scatter-gather fragments (byte offsets into the test buffers). The
+// testbench sets MEMCOPY_DESC_LAST on the second to last entry.
+struct tb_sg_frag { uint32_t src, dst, len; };
+static const tb_sg_frag tb_sg_frags[] = {
+    {    0,    0,   64 },
+    {  100,  203,  333 },
+    {    7, 1024,    1 },
+    { 2048,  600,  128 },
+    {  513, 1100,  999 },
+    {   60, 2200,   17 },
+    { 3000, 3000,  256 },   // not executed
+};
+#define TB_NUM_SG_FRAGS ((int)(sizeof(tb_sg_frags) / sizeof(tb_sg_frags[0])))
+
+// 2D strided cases: aligned tile, odd row length and pitches, a pitch
+// smaller than the bus width, a single row, and zero rows.
+struct tb_2d_case { uint32_t src_off, dst_off, rows, row_bytes, src_stride, dst_stride; };
+static const tb_2d_case tb_2d_cases[] = {
+    {   0,    0, 16,  64, 128,  64 },
+    {   3,    5, 13,  37, 100,  61 },
+    {   1,    6, 40,   3,   5,  11 },
+    { 512,  900,  1, 555,   0,   0 },
+    {  70, 1000,  7, 200, 256, 300 },
+    {   0,    0,  0,  64,  64,  64 },
+};
+#define TB_NUM_2D_CASES ((int)(sizeof(tb_2d_cases) / sizeof(tb_2d_cases[0])))
+
+// Byte offsets (within the compared range) flipped by the compare test,
+// applied cumulatively: not sorted, so the first mismatch is not simply
+// the first flip; two share a beat; the last is the final byte.
+static const uint32_t tb_cmp_flips[] = { 700, 3, 4, 0, 1500, 1234 };
+#define TB_NUM_CMP_FLIPS ((int)(sizeof(tb_cmp_flips) / sizeof(tb_cmp_flips[0])))
+
+// Buffer size and repeat count for the throughput report.
+// sweep_burst.tcl builds with -DTB_BENCH_ONLY -DTB_BENCH_ITERS=1 so each
+// top is called exactly once and the cosim latency is for TB_BENCH_BYTES.
+#ifndef TB_BENCH_BYTES
+#define TB_BENCH_BYTES  (64 * 1024)
+#endif
+#ifndef TB_BENCH_ITERS
+#define TB_BENCH_ITERS  20
+#endif
@@ -1,11 +1,690 @@
 #include <iostream>
 #include <cstdlib>
 #include <cstring>
+#include <chrono>
+#include <iomanip>
+#include "memcopy_accel.h"
 #include "memcopy_accel_tb_data.h"
 
-void memcopy_accel(uint32_t* src, uint32_t* dst, uint32_t len);
+// Pack a little-endian byte image into W-bit bus beats
+template <int W>
+void pack_beats(const uint8_t* bytes, ap_uint<W>* beats, int num_beats) {
+    const int BYTES = W / 8;
+    for (int i = 0; i < num_beats; i++) {
+        ap_uint<W> v = 0;
+        for (int b = BYTES - 1; b >= 0; b--) {
+            v = v << 8;
+            v = v | ap_uint<W>(bytes[i * BYTES + b]);
+        }
+        beats[i] = v;
+    }
+}
+
+template <int W>
+void unpack_beats(const ap_uint<W>* beats, uint8_t* bytes, int num_beats) {
+    const int BYTES = W / 8;
+    for (int i = 0; i < num_beats; i++) {
+        ap_uint<W> v = beats[i];
+        for (int b = 0; b < BYTES; b++) {
+            bytes[i * BYTES + b] = (uint8_t)(v & ap_uint<W>(0xFF)).to_uint();
+            v = v >> 8;
+        }
+    }
+}
+
+// Table-driven CRC-32 (zlib crc32()) as the software reference for the
+// bitwise one in the kernel. Pass 0 to start, chain by passing the result.
+uint32_t ref_crc32(uint32_t crc, const uint8_t* p, uint32_t n) {
+    static uint32_t table[256];
+    if (table[1] == 0) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? (c >> 1) ^ 0xEDB88320u : c >> 1;
+            table[i] = c;
+        }
+    }
+    crc = ~crc;
+    for (uint32_t i = 0; i < n; i++)
+        crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// Sink for the perf_* outputs of the top where a test does not check them
+static uint32_t tb_perf[4];
+#define TB_PERF_ARGS &tb_perf[0], &tb_perf[1], &tb_perf[2], &tb_perf[3]
+// cpl/ring_prod/irq_count/irq_idle for every op but MEMCOPY_OP_RING
+#define TB_NO_RING 0, 0, 0, 0
+
+int check_crc(const char* what, uint32_t got, uint32_t expect) {
+    if (got == expect)
+        return 0;
+    std::cout << "  " << what << " crc mismatch: ref=0x" << std::hex << expect
+              << " got=0x" << got << std::dec << std::endl;
+    return 1;
+}
+
+// Run a W-bit kernel and the 32-bit memcopy_accel_word on the same data and
+// compare the whole destination buffer, including bytes past len.
+template <int W>
+int test_wide_vs_32(void (*kernel)(const ap_uint<W>*, ap_uint<W>*, uint32_t),
+                    const char* name, uint32_t len) {
+    const int BYTES = W / 8;
+    const int NUM_BEATS = (TB_MAX_BYTES + BYTES - 1) / BYTES;
+    static uint32_t src32[TB_MAX_WORDS], dst32[TB_MAX_WORDS];
+    static ap_uint<W> src_w[NUM_BEATS], dst_w[NUM_BEATS];
+    static uint8_t ref[TB_MAX_BYTES], out[TB_MAX_BYTES];
+
+    for (int i = 0; i < TB_MAX_WORDS; i++) {
+        src32[i] = 0xA5A50000u | i;
+        dst32[i] = TB_GUARD_WORD;
+    }
+    pack_beats<W>((const uint8_t*)src32, src_w, NUM_BEATS);
+    pack_beats<W>((const uint8_t*)dst32, dst_w, NUM_BEATS);
+
+    memcopy_accel_word(src32, dst32, len);
+    kernel(src_w, dst_w, len);
+
+    memcpy(ref, dst32, TB_MAX_BYTES);
+    unpack_beats<W>(dst_w, out, NUM_BEATS);
+
+    int errors = 0;
+    for (int i = 0; i < TB_MAX_BYTES; i++) {
+        if (ref[i] != out[i]) {
+            if (errors < 8)
+                std::cout << "  " << name << "<" << W << "> len=" << len << " mismatch at byte " << i
+                          << ": ref=0x" << std::hex << (int)ref[i]
+                          << " got=0x" << (int)out[i] << std::dec << std::endl;
+            errors++;
+        }
+    }
+    return errors;
+}
+
+// Byte-exact kernel against a byte-wise reference copy for one
+// (len, src_off, dst_off) combination; bytes outside the copy must keep
+// the guard pattern. dst_bytes aliases dst, as the driver programs it.
+template <int W>
+int test_unaligned(uint32_t len, uint32_t src_off, uint32_t dst_off) {
+    const int BYTES = W / 8;
+    const int NUM_BEATS = TB_MAX_BYTES / BYTES;
+    static ap_uint<W> src_w[NUM_BEATS], dst_w[NUM_BEATS];
+    static uint8_t src_b[TB_MAX_BYTES], ref[TB_MAX_BYTES], out[TB_MAX_BYTES];
+
+    for (int i = 0; i < TB_MAX_BYTES; i++) {
+        src_b[i] = (uint8_t)(i * 7 + 3);
+        ref[i] = (uint8_t)(TB_GUARD_WORD >> (8 * (i & 3)));
+    }
+    pack_beats<W>(src_b, src_w, NUM_BEATS);
+    pack_beats<W>(ref, dst_w, NUM_BEATS);
+    memcpy(&ref[dst_off], &src_b[src_off], len);
+
+    uint32_t crc = 0;
+    memcopy_unaligned<W>(src_w, dst_w, (uint8_t*)dst_w, len, src_off, dst_off, MEMCOPY_CRC_INIT, crc);
+    unpack_beats<W>(dst_w, out, NUM_BEATS);
+
+    int errors = check_crc("memcopy_unaligned", ~crc, ref_crc32(0, &src_b[src_off], len));
+    for (int i = 0; i < TB_MAX_BYTES; i++) {
+        if (ref[i] != out[i]) {
+            if (errors < 4)
+                std::cout << "  memcopy_unaligned<" << W << "> len=" << len
+                          << " src_off=" << src_off << " dst_off=" << dst_off
+                          << " mismatch at byte " << i << ": ref=0x" << std::hex << (int)ref[i]
+                          << " got=0x" << (int)out[i] << std::dec << std::endl;
+            errors++;
+        }
+    }
+    return errors;
+}
+
+template <int W>
+int test_unaligned_all() {
+    const uint32_t BYTES = W / 8;
+    int errors = 0;
+    for (int i = 0; i < TB_NUM_UNALIGNED_LENS; i++)
+        for (uint32_t so = 0; so < BYTES; so++)
+            for (uint32_t d = 0; d < BYTES; d++)
+                errors += test_unaligned<W>(tb_unaligned_lens[i], so, d);
+    return errors;
+}
+
+// Reference transform: source bytes -> destination bytes, returns the
+// number of bytes written
+uint32_t ref_transform(uint32_t op, const uint8_t* in, uint32_t len, uint8_t* out) {
+    uint32_t e = (op == MEMCOPY_OP_SWAP16) ? 2 : (op == MEMCOPY_OP_SWAP32) ? 4 : 8;
+    switch (op) {
+    case MEMCOPY_OP_SWAP16:
+    case MEMCOPY_OP_SWAP32:
+    case MEMCOPY_OP_SWAP64:
+        for (uint32_t i = 0; i < len; i++) {
+            uint32_t base = i - i % e;
+            out[i] = (base + e <= len) ? in[base + (e - 1 - i % e)] : in[i];
+        }
+        return len;
+    case MEMCOPY_OP_WIDEN16:
+    case MEMCOPY_OP_WIDEN32: {
+        uint32_t k = (op == MEMCOPY_OP_WIDEN16) ? 2 : 4;
+        for (uint32_t i = 0; i < len * k; i++)
+            out[i] = (i % k == 0) ? in[i / k] : 0;
+        return len * k;
+    }
+    }
+    return 0;
+}
+
+// One transform at one (len, src_off, dst_off) against ref_transform,
+// guard bytes and CRC included
+template <int W>
+int test_transform(uint32_t op, uint32_t len, uint32_t src_off, uint32_t dst_off) {
+    const int BYTES = W / 8;
+    const int NUM_BEATS = TB_MAX_BYTES / BYTES;
+    static ap_uint<W> src_w[NUM_BEATS], dst_w[NUM_BEATS];
+    static uint8_t src_b[TB_MAX_BYTES], ref[TB_MAX_BYTES], out[TB_MAX_BYTES];
+
+    for (int i = 0; i < TB_MAX_BYTES; i++) {
+        src_b[i] = (uint8_t)(i * 29 + 7);
+        ref[i] = 0x5A;
+    }
+    pack_beats<W>(src_b, src_w, NUM_BEATS);
+    pack_beats<W>(ref, dst_w, NUM_BEATS);
+    uint32_t out_len = ref_transform(op, &src_b[src_off], len, &ref[dst_off]);
+
+    uint32_t crc = 0;
+    memcopy_transform<W>(src_w, dst_w, (uint8_t*)dst_w, len, src_off, dst_off, op, crc);
+    unpack_beats<W>(dst_w, out, NUM_BEATS);
+
+    int errors = check_crc("transform", ~crc, ref_crc32(0, &ref[dst_off], out_len));
+    for (int i = 0; i < TB_MAX_BYTES; i++) {
+        if (ref[i] != out[i]) {
+            if (errors < 4)
+                std::cout << "  memcopy_transform<" << W << "> op=" << op << " len=" << len
+                          << " src_off=" << src_off << " dst_off=" << dst_off
+                          << " mismatch at byte " << i << ": ref=0x" << std::hex << (int)ref[i]
+                          << " got=0x" << (int)out[i] << std::dec << std::endl;
+            errors++;
+        }
+    }
+    return errors;
+}
+
+// Every transform, every tb_unaligned_lens entry that fits once widened,
+// at the edge and mid-beat src/dst offsets (the realign path itself is
+// covered for every offset by test_unaligned_all)
+template <int W>
+int test_transform_all() {
+    const uint32_t BYTES = W / 8;
+    const uint32_t offs[] = { 0, 1, BYTES / 2 + 1, BYTES - 1 };
+    int errors = 0;
+    for (uint32_t op = MEMCOPY_OP_SWAP16; op <= MEMCOPY_OP_WIDEN32; op++) {
+        uint32_t k = (op == MEMCOPY_OP_WIDEN16) ? 2 : (op == MEMCOPY_OP_WIDEN32) ? 4 : 1;
+        for (int i = 0; i < TB_NUM_UNALIGNED_LENS; i++) {
+            if (tb_unaligned_lens[i] * k + BYTES > TB_MAX_BYTES)
+                continue;
+            for (int so = 0; so < 4; so++)
+                for (int d = 0; d < 4; d++)
+                    errors += test_transform<W>(op, tb_unaligned_lens[i], offs[so], offs[d]);
+        }
+    }
+    return errors;
+}
+
+// Scatter-gather: a chain of fragments with mixed offsets and lengths,
+// written as descriptors into a beat array and run through the top.
+// The last descriptor of tb_sg_frags is never executed (the one before it
+// carries MEMCOPY_DESC_LAST), so its destination must stay untouched.
+int test_scatter_gather() {
+    const int BYTES = MEMCOPY_BUS_WIDTH / 8;
+    const int NUM_BEATS = TB_MAX_BYTES / BYTES;
+    const int DESC_BEATS = MEMCOPY_DESC_BYTES / BYTES;
+    static memcopy_beat_t src_w[NUM_BEATS], dst_w[NUM_BEATS];
+    static memcopy_beat_t desc_w[TB_NUM_SG_FRAGS * DESC_BEATS];
+    static uint8_t src_b[TB_MAX_BYTES], ref[TB_MAX_BYTES], out[TB_MAX_BYTES];
+    static uint8_t desc_b[TB_NUM_SG_FRAGS * MEMCOPY_DESC_BYTES];
+
+    for (int i = 0; i < TB_MAX_BYTES; i++) {
+        src_b[i] = (uint8_t)(i * 13 + 1);
+        ref[i] = 0x5A;
+    }
+    pack_beats<MEMCOPY_BUS_WIDTH>(src_b, src_w, NUM_BEATS);
+    pack_beats<MEMCOPY_BUS_WIDTH>(ref, dst_w, NUM_BEATS);
+
+    memset(desc_b, 0, sizeof(desc_b));
+    for (int i = 0; i < TB_NUM_SG_FRAGS; i++) {
+        uint8_t* d = &desc_b[i * MEMCOPY_DESC_BYTES];
+        uint64_t s = tb_sg_frags[i].src, t = tb_sg_frags[i].dst;
+        uint32_t n = tb_sg_frags[i].len;
+        uint32_t flags = (i == TB_NUM_SG_FRAGS - 2) ? MEMCOPY_DESC_LAST : 0;
+        memcpy(d + 0, &s, 8);
+        memcpy(d + 8, &t, 8);
+        memcpy(d + 16, &n, 4);
+        memcpy(d + 20, &flags, 4);
+        if (i < TB_NUM_SG_FRAGS - 1)
+            memcpy(&ref[t], &src_b[s], n);
+    }
+    pack_beats<MEMCOPY_BUS_WIDTH>(desc_b, desc_w, TB_NUM_SG_FRAGS * DESC_BEATS);
+
+    uint32_t crc = 0, ref_crc = 0;
+    for (int i = 0; i < TB_NUM_SG_FRAGS - 1; i++)
+        ref_crc = ref_crc32(ref_crc, &src_b[tb_sg_frags[i].src], tb_sg_frags[i].len);
+
+    memcopy_accel(src_w, dst_w, TB_NUM_SG_FRAGS, 0, 0, (uint8_t*)dst_w, MEMCOPY_OP_SG, desc_w, 0, 0, 0, 0, 0, &crc, 0, 0, 0,
+                  TB_PERF_ARGS, TB_NO_RING);
+    unpack_beats<MEMCOPY_BUS_WIDTH>(dst_w, out, NUM_BEATS);
+
+    int errors = check_crc("scatter-gather", crc, ref_crc);
+    for (int i = 0; i < TB_MAX_BYTES; i++) {
+        if (ref[i] != out[i]) {
+            if (errors < 8)
+                std::cout << "  scatter-gather mismatch at byte " << i << ": ref=0x" << std::hex
+                          << (int)ref[i] << " got=0x" << (int)out[i] << std::dec << std::endl;
+            errors++;
+        }
+    }
+    return errors;
+}
+
+// 2D strided copy through the top: every tb_2d_cases entry against a
+// row-by-row memcpy, checking the gaps between destination rows too.
+int test_2d() {
+    const int BYTES = MEMCOPY_BUS_WIDTH / 8;
+    const int NUM_BEATS = TB_MAX_BYTES / BYTES;
+    static memcopy_beat_t src_w[NUM_BEATS], dst_w[NUM_BEATS];
+    static uint8_t src_b[TB_MAX_BYTES], ref[TB_MAX_BYTES], out[TB_MAX_BYTES];
+    int errors = 0;
+
+    for (int c = 0; c < TB_NUM_2D_CASES; c++) {
+        const tb_2d_case& t = tb_2d_cases[c];
+        for (int i = 0; i < TB_MAX_BYTES; i++) {
+            src_b[i] = (uint8_t)(i * 5 + c);
+            ref[i] = 0x5A;
+        }
+        pack_beats<MEMCOPY_BUS_WIDTH>(src_b, src_w, NUM_BEATS);
+        pack_beats<MEMCOPY_BUS_WIDTH>(ref, dst_w, NUM_BEATS);
+        uint32_t crc = 0, ref_crc = 0;
+        for (uint32_t r = 0; r < t.rows; r++) {
+            memcpy(&ref[t.dst_off + r * t.dst_stride], &src_b[t.src_off + r * t.src_stride], t.row_bytes);
+            ref_crc = ref_crc32(ref_crc, &src_b[t.src_off + r * t.src_stride], t.row_bytes);
+        }
+
+        memcopy_accel(src_w, dst_w, 0, t.src_off, t.dst_off, (uint8_t*)dst_w, MEMCOPY_OP_2D, 0,
+                      t.rows, t.row_bytes, t.src_stride, t.dst_stride, 0, &crc, 0, 0, 0, TB_PERF_ARGS, TB_NO_RING);
+        unpack_beats<MEMCOPY_BUS_WIDTH>(dst_w, out, NUM_BEATS);
+        errors += check_crc("2d", crc, ref_crc);
+
+        for (int i = 0; i < TB_MAX_BYTES; i++) {
+            if (ref[i] != out[i]) {
+                if (errors < 8)
+                    std::cout << "  2d case " << c << " mismatch at byte " << i << ": ref=0x" << std::hex
+                              << (int)ref[i] << " got=0x" << (int)out[i] << std::dec << std::endl;
+                errors++;
+            }
+        }
+    }
+    return errors;
+}
+
+// Fill and pattern modes through the top with src = 0, so any read of the
+// source port would fault in csim. Each tb_unaligned_lens entry at a few
+// destination offsets, against a byte reference built from 32-bit words.
+int test_fill(uint32_t op, uint32_t fill) {
+    const int BYTES = MEMCOPY_BUS_WIDTH / 8;
+    const int NUM_BEATS = TB_MAX_BYTES / BYTES;
+    static memcopy_beat_t dst_w[NUM_BEATS];
+    static uint8_t ref[TB_MAX_BYTES], out[TB_MAX_BYTES];
+    int errors = 0;
+
+    for (int i = 0; i < TB_NUM_UNALIGNED_LENS; i++) {
+        for (uint32_t d = 0; d < (uint32_t)BYTES; d += 3) {
+            uint32_t len = tb_unaligned_lens[i];
+            memset(ref, 0x5A, sizeof(ref));
+            pack_beats<MEMCOPY_BUS_WIDTH>(ref, dst_w, NUM_BEATS);
+            for (uint32_t b = 0; b < len; b++) {
+                uint32_t word = fill + ((op == MEMCOPY_OP_PATTERN) ? b / 4 : 0);
+                ref[d + b] = (uint8_t)(word >> (8 * (b % 4)));
+            }
+
+            uint32_t crc = 0;
+            memcopy_accel(0, dst_w, len, 0, d, (uint8_t*)dst_w, op, 0, 0, 0, 0, 0, fill, &crc, 0, 0, 0,
+                          TB_PERF_ARGS, TB_NO_RING);
+            unpack_beats<MEMCOPY_BUS_WIDTH>(dst_w, out, NUM_BEATS);
+            errors += check_crc("fill", crc, ref_crc32(0, &ref[d], len));
+
+            for (int k = 0; k < TB_MAX_BYTES; k++) {
+                if (ref[k] != out[k]) {
+                    if (errors < 8)
+                        std::cout << "  fill op=" << op << " len=" << len << " dst_off=" << d
+                                  << " mismatch at byte " << k << ": ref=0x" << std::hex << (int)ref[k]
+                                  << " got=0x" << (int)out[k] << std::dec << std::endl;
+                    errors++;
+                }
+            }
+        }
+    }
+    return errors;
+}
+
+// Compare mode through the top: equal buffers at every (src_off, dst_off),
+// then the same buffers with bytes flipped at tb_cmp_flips. Neither buffer
+// may be modified.
+int test_compare() {
+    const int BYTES = MEMCOPY_BUS_WIDTH / 8;
+    const int NUM_BEATS = TB_MAX_BYTES / BYTES;
+    const uint32_t LEN = 1501;
+    static memcopy_beat_t a_w[NUM_BEATS], b_w[NUM_BEATS];
+    static uint8_t a[TB_MAX_BYTES], b[TB_MAX_BYTES], out[TB_MAX_BYTES];
+    int errors = 0;
+
+    for (uint32_t so = 0; so < (uint32_t)BYTES; so++) {
+        for (uint32_t d = 0; d < (uint32_t)BYTES; d++) {
+            for (int f = 0; f <= TB_NUM_CMP_FLIPS; f++) {
+                for (int i = 0; i < TB_MAX_BYTES; i++)
+                    a[i] = b[i] = (uint8_t)(i * 3 + 11);
+                memcpy(&b[d], &a[so], LEN);
+                // guard bytes around the dst range differ, they must not count
+                b[d + LEN] ^= 0xFF;
+                if (d > 0)
+                    b[d - 1] ^= 0xFF;
+
+                // first f entries of tb_cmp_flips applied
+                uint64_t ref_first = MEMCOPY_CMP_NONE, ref_count = 0;
+                for (int k = 0; k < f; k++) {
+                    uint32_t off = tb_cmp_flips[k];
+                    b[d + off] ^= 0x10;
+                    ref_count++;
+                    if (off < ref_first)
+                        ref_first = off;
+                }
+                pack_beats<MEMCOPY_BUS_WIDTH>(a, a_w, NUM_BEATS);
+                pack_beats<MEMCOPY_BUS_WIDTH>(b, b_w, NUM_BEATS);
+
+                uint32_t crc, match = 2;
+                uint64_t first = 0, count = 0;
+                memcopy_accel(a_w, b_w, LEN, so, d, (uint8_t*)b_w, MEMCOPY_OP_CMP, 0, 0, 0, 0, 0, 0,
+                              &crc, &match, &first, &count, TB_PERF_ARGS, TB_NO_RING);
+
+                unpack_beats<MEMCOPY_BUS_WIDTH>(b_w, out, NUM_BEATS);
+                bool untouched = memcmp(out, b, TB_MAX_BYTES) == 0;
+                if (match != (ref_count == 0 ? 1u : 0u) || first != ref_first || count != ref_count || !untouched) {
+                    if (errors < 8)
+                        std::cout << "  compare src_off=" << so << " dst_off=" << d << " flips=" << f
+                                  << ": match=" << match << " first=" << first << " count=" << count
+                                  << " (ref " << (ref_count == 0) << " " << ref_first << " " << ref_count
+                                  << ")" << (untouched ? "" : " dst modified") << std::endl;
+                    errors++;
+                }
+            }
+        }
+    }
+    return errors;
+}
+
+// AXI data beats a byte-exact transfer of len bytes at byte offset off
+// should move, counted beat by beat: every beat touched is one read beat;
+// a fully covered beat is one write beat, a partial one a beat per byte.
+static void ref_beats(uint32_t off, uint32_t len, uint32_t& rd, uint32_t& wr) {
+    const uint32_t BYTES = MEMCOPY_BUS_WIDTH / 8;
+    rd = wr = 0;
+    for (uint32_t b = 0; len != 0 && b * BYTES < off + len; b++) {
+        uint32_t lo = b * BYTES > off ? b * BYTES : off;
+        uint32_t hi = (b + 1) * BYTES < off + len ? (b + 1) * BYTES : off + len;
+        if (hi <= lo)
+            continue;
+        rd++;
+        wr += (hi - lo == BYTES) ? 1 : hi - lo;
+    }
+}
+
+// perf_* registers: beat counts of a copy, a fill and a compare against
+// ref_beats; csim reports no cycles, so only stall <= cycles is checked
+int test_perf() {
+    const int BYTES = MEMCOPY_BUS_WIDTH / 8;
+    const int NUM_BEATS = TB_MAX_BYTES / BYTES;
+    static memcopy_beat_t a_w[NUM_BEATS], b_w[NUM_BEATS];
+    const uint32_t lens[] = { 0, 1, 7, 64, 1000, 1501 };
+    const uint32_t offs[] = { 0, 1, (uint32_t)BYTES - 1 };
+    int errors = 0;
+
+    for (int i = 0; i < 6; i++)
+        for (int so = 0; so < 3; so++)
+            for (int d = 0; d < 3; d++) {
+                uint32_t len = lens[i], s = offs[so], t = offs[d];
+                uint32_t s_rd, s_wr, d_rd, d_wr;
+                ref_beats(s, len, s_rd, s_wr);
+                ref_beats(t, len, d_rd, d_wr);
+                const struct { uint32_t op, rd, wr; } runs[] = {
+                    { MEMCOPY_OP_COPY, s_rd,        d_wr },
+                    { MEMCOPY_OP_FILL, 0,           d_wr },
+                    { MEMCOPY_OP_CMP,  s_rd + d_rd, 0    },
+                };
+                for (int r = 0; r < 3; r++) {
+                    uint32_t crc, match, cycles, rd, wr, stall;
+                    uint64_t first, count;
+                    memcopy_accel(a_w, b_w, len, s, t, (uint8_t*)b_w, runs[r].op, 0, 0, 0, 0, 0, 0,
+                                  &crc, &match, &first, &count, &cycles, &rd, &wr, &stall, TB_NO_RING);
+                    if (rd != runs[r].rd || wr != runs[r].wr || stall > cycles) {
+                        if (errors < 8)
+                            std::cout << "  perf op=" << runs[r].op << " len=" << len << " src_off=" << s
+                                      << " dst_off=" << t << ": rd=" << rd << " wr=" << wr
+                                      << " (ref " << runs[r].rd << " " << runs[r].wr << ") cycles="
+                                      << cycles << " stall=" << stall << std::endl;
+                        errors++;
+                    }
+                }
+            }
+    return errors;
+}
+
+// 64-bit lengths: the beat counts the kernel loops run for, at lengths
+// around and above 4 GiB (too large to copy in csim), against a closed form
+template <int W>
+int test_len64() {
+    const uint64_t B = W / 8;
+    const uint64_t lens[] = { 0xFFFFFFFFull, 0x100000000ull, 0x100000001ull, 0x140000003ull, (1ull << 40) + 7 };
+    const uint32_t offs[] = { 0, 1, (uint32_t)B - 1 };
+    int errors = 0;
+
+    for (int i = 0; i < 5; i++)
+        for (int o = 0; o < 3; o++) {
+            uint64_t len = lens[i], off = offs[o], end = off + len;
+            uint64_t first_full = (off + B - 1) / B, last_full = end / B;
+            uint64_t wr = (last_full > first_full) ? last_full - first_full : 0;
+            if (first_full * B > off)
+                wr += ((first_full * B < end) ? first_full * B : end) - off;
+            if (last_full >= first_full && end > last_full * B)
+                wr += end - last_full * B;
+            uint64_t rd = (end + B - 1) / B;
+
+            memcopy_len_t got_rd = memcopy_read_beats<W>(offs[o], len);
+            memcopy_len_t got_wr = memcopy_write_beats<W>(offs[o], len);
+            if (got_rd != rd || got_wr != wr) {
+                if (errors < 8)
+                    std::cout << "  len64 W=" << W << " len=" << len << " off=" << off << ": rd=" << got_rd
+                              << " wr=" << got_wr << " (ref " << rd << " " << wr << ")" << std::endl;
+                errors++;
+            }
+        }
+    return errors;
+}
+
+// Command ring over 8 slots: the tb_sg_frags jobs in one batch that ends
+// with MEMCOPY_DESC_STOP and is drained irq_count at a time, then the first
+// five again in a batch that wraps the ring and returns on the idle limit.
+// Checks the data, every completion entry, the number of runs (interrupts)
+// and that the consumer index carries over from one run to the next.
+int test_ring() {
+    const int BYTES = MEMCOPY_BUS_WIDTH / 8;
+    const int NUM_BEATS = TB_MAX_BYTES / BYTES;
+    const int DESC_BEATS = MEMCOPY_DESC_BYTES / BYTES;
+    const uint32_t SLOTS = 8, IRQ_COUNT = 3, IRQ_IDLE = 4;
+    static memcopy_beat_t src_w[NUM_BEATS], dst_w[NUM_BEATS];
+    static memcopy_beat_t ring_w[SLOTS * DESC_BEATS], cpl_w[(1 + SLOTS) * DESC_BEATS];
+    static uint8_t src_b[TB_MAX_BYTES], ref[TB_MAX_BYTES], out[TB_MAX_BYTES];
+    static uint8_t ring_b[SLOTS * MEMCOPY_DESC_BYTES], cpl_b[(1 + SLOTS) * MEMCOPY_DESC_BYTES];
+    volatile uint32_t prod = 0;
+    int errors = 0;
+
+    for (int i = 0; i < TB_MAX_BYTES; i++)
+        src_b[i] = (uint8_t)(i * 7 + 3);
+    pack_beats<MEMCOPY_BUS_WIDTH>(src_b, src_w, NUM_BEATS);
+    memset(ring_b, 0, sizeof(ring_b));
+    memset(cpl_b, 0, sizeof(cpl_b));
+    pack_beats<MEMCOPY_BUS_WIDTH>(cpl_b, cpl_w, (1 + SLOTS) * DESC_BEATS);
+
+    for (int batch = 0; batch < 2; batch++) {
+        const uint32_t num_jobs = (batch == 0) ? TB_NUM_SG_FRAGS : 5;
+        const int expect_runs = (batch == 0) ? 3 : 2;
+        const uint32_t first = prod;
+
+        memset(ref, 0x5A, TB_MAX_BYTES);
+        pack_beats<MEMCOPY_BUS_WIDTH>(ref, dst_w, NUM_BEATS);
+        for (uint32_t j = 0; j < num_jobs; j++) {
+            uint8_t* d = &ring_b[((first + j) % SLOTS) * MEMCOPY_DESC_BYTES];
+            uint64_t s = tb_sg_frags[j].src, t = tb_sg_frags[j].dst, cookie = 0x1000 + first + j;
+            uint32_t n = tb_sg_frags[j].len;
+            uint32_t flags = (batch == 0 && j == num_jobs - 1) ? MEMCOPY_DESC_STOP : 0;
+            memcpy(d + 0, &s, 8);
+            memcpy(d + 8, &t, 8);
+            memcpy(d + 16, &n, 4);
+            memcpy(d + 20, &flags, 4);
+            memcpy(d + 24, &cookie, 8);
+            memcpy(&ref[t], &src_b[s], n);
+        }
+        pack_beats<MEMCOPY_BUS_WIDTH>(ring_b, ring_w, SLOTS * DESC_BEATS);
+        prod = first + num_jobs;   // doorbell
+
+        int runs = 0;
+        uint32_t cons = first, crc = 0;
+        while (cons != prod && runs < 8) {
+            memcopy_accel(src_w, dst_w, SLOTS, 0, 0, (uint8_t*)dst_w, MEMCOPY_OP_RING, ring_w, 0, 0, 0, 0, 0,
+                          &crc, 0, 0, 0, TB_PERF_ARGS, cpl_w, &prod, IRQ_COUNT, IRQ_IDLE);
+            unpack_beats<MEMCOPY_BUS_WIDTH>(cpl_w, cpl_b, (1 + SLOTS) * DESC_BEATS);
+            memcpy(&cons, cpl_b, 4);
+            runs++;
+        }
+        if (runs != expect_runs || cons != prod) {
+            std::cout << "  ring batch " << batch << ": " << runs << " runs (ref " << expect_runs
+                      << "), consumer " << cons << " (ref " << prod << ")" << std::endl;
+            errors++;
+        }
+        if (batch == 0) {
+            // The run auto_restart starts after the stop command's run returns
+            // at once on the stopped, empty ring
+            uint32_t extra_crc = crc;
+            memcopy_accel(src_w, dst_w, SLOTS, 0, 0, (uint8_t*)dst_w, MEMCOPY_OP_RING, ring_w, 0, 0, 0, 0, 0,
+                          &extra_crc, 0, 0, 0, TB_PERF_ARGS, cpl_w, &prod, IRQ_COUNT, IRQ_IDLE);
+            unpack_beats<MEMCOPY_BUS_WIDTH>(cpl_w, cpl_b, (1 + SLOTS) * DESC_BEATS);
+            memcpy(&cons, cpl_b, 4);
+            if (cons != prod) {
+                std::cout << "  ring: run after stop consumed up to " << cons << " (ref " << prod << ")"
+                          << std::endl;
+                errors++;
+            }
+        }
+
+        for (uint32_t j = 0; j < num_jobs; j++) {
+            const uint8_t* c = &cpl_b[(1 + (first + j) % SLOTS) * MEMCOPY_DESC_BYTES];
+            uint64_t cookie;
+            uint32_t status, c_crc, len, seq;
+            memcpy(&cookie, c + 0, 8);
+            memcpy(&status, c + 8, 4);
+            memcpy(&c_crc, c + 12, 4);
+            memcpy(&len, c + 16, 4);
+            memcpy(&seq, c + 20, 4);
+            uint32_t ref_status = MEMCOPY_CPL_DONE |
+                ((batch == 0 && j == num_jobs - 1) ? MEMCOPY_CPL_STOP : 0u);
+            uint32_t ref_c = ref_crc32(0, &src_b[tb_sg_frags[j].src], tb_sg_frags[j].len);
+            if (cookie != 0x1000 + first + j || status != ref_status || c_crc != ref_c ||
+                len != tb_sg_frags[j].len || seq != first + j + 1) {
+                if (errors < 8)
+                    std::cout << "  ring completion " << first + j << ": cookie=0x" << std::hex << cookie
+                              << " status=0x" << status << " crc=0x" << c_crc << std::dec << " len=" << len
+                              << " seq=" << seq << std::endl;
+                errors++;
+            }
+            if (j == num_jobs - 1)
+                errors += check_crc("ring last job", crc, ref_c);
+        }
+
+        unpack_beats<MEMCOPY_BUS_WIDTH>(dst_w, out, NUM_BEATS);
+        for (int i = 0; i < TB_MAX_BYTES; i++) {
+            if (ref[i] != out[i]) {
+                if (errors < 8)
+                    std::cout << "  ring batch " << batch << " mismatch at byte " << i << ": ref=0x" << std::hex
+                              << (int)ref[i] << " got=0x" << (int)out[i] << std::dec << std::endl;
+                errors++;
+            }
+        }
+    }
+    return errors;
+}
+
+// Byte-exact top with aligned buffers, same signature as the wide tops
+static void tb_memcopy_accel(memcopy_beat_t* src, memcopy_beat_t* dst, uint32_t len) {
+    uint32_t crc;
+    memcopy_accel(src, dst, len, 0, 0, (uint8_t*)dst, MEMCOPY_OP_COPY, 0, 0, 0, 0, 0, 0, &crc, 0, 0, 0,
+                  TB_PERF_ARGS, TB_NO_RING);
+}
+
+// Host wall time of each top function on the same buffer. Under csim every
+// row is the C model on the host CPU, so the figures say nothing about the
+// hardware and the rows must not be compared with each other as speedups.
+// Hardware throughput comes from cosim: the cosim report gives the latency
+// in cycles of the function selected with set_top (sweep_burst.tcl collects
+// it per configuration as bytes/cycle).
+typedef void (*tb_kernel32_t)(uint32_t*, uint32_t*, uint32_t);
+typedef void (*tb_kernel_wide_t)(memcopy_beat_t*, memcopy_beat_t*, uint32_t);
+
+static double tb_time_us(tb_kernel32_t k32, tb_kernel_wide_t kw, uint32_t len) {
+    const int NUM_BEATS = TB_BENCH_BYTES / (MEMCOPY_BUS_WIDTH / 8);
+    static uint32_t src32[TB_BENCH_BYTES / 4], dst32[TB_BENCH_BYTES / 4];
+    static memcopy_beat_t src_w[NUM_BEATS], dst_w[NUM_BEATS];
+
+    for (int i = 0; i < TB_BENCH_BYTES / 4; i++)
+        src32[i] = 0xA5A50000u | i;
+    pack_beats<MEMCOPY_BUS_WIDTH>((const uint8_t*)src32, src_w, NUM_BEATS);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int it = 0; it < TB_BENCH_ITERS; it++) {
+        if (k32)
+            k32(src32, dst32, len);
+        else
+            kw(src_w, dst_w, len);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / TB_BENCH_ITERS;
+}
+
+static void report_throughput() {
+    const uint32_t len = TB_BENCH_BYTES;
+    const uint32_t beats = len / (MEMCOPY_BUS_WIDTH / 8);
+    struct { const char* name; tb_kernel32_t k32; tb_kernel_wide_t kw; } kernels[] = {
+        { "memcopy_accel_word",     memcopy_accel_word, 0 },
+        { "memcopy_accel_wide",     0, memcopy_accel_wide },
+        { "memcopy_accel_dataflow", 0, memcopy_accel_dataflow },
+        { "memcopy_accel",          0, tb_memcopy_accel },
+    };
+    const int num_kernels = sizeof(kernels) / sizeof(kernels[0]);
+
+    std::cout << std::endl << "C-model wall time, not hardware throughput (" << len << " bytes, " << beats
+              << " x " << MEMCOPY_BUS_WIDTH << "-bit beats, " << TB_BENCH_ITERS << " iterations)" << std::endl;
+    std::cout << "cycles: cosim report latency, see sweep_burst.tcl" << std::endl;
+    std::cout << "config: MEMCOPY_MAX_BURST=" << MEMCOPY_MAX_BURST
+              << " MEMCOPY_NUM_OUTSTANDING=" << MEMCOPY_NUM_OUTSTANDING << std::endl;
+    std::cout << std::left << std::setw(26) << "kernel" << std::right
+              << std::setw(14) << "host us/call" << std::setw(14) << "host MB/s" << std::endl;
+
+    for (int i = 0; i < num_kernels; i++) {
+        double us = tb_time_us(kernels[i].k32, kernels[i].kw, len);
+        std::cout << std::left << std::setw(26) << kernels[i].name << std::right
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(14) << us
+                  << std::setw(14) << (us > 0 ? len / us : 0.0) << std::endl;
+    }
+}
 
 int main() {
+    int errors = 0;
+#ifndef TB_BENCH_ONLY
     const int SIZE = 64;
     uint32_t src[SIZE];
     uint32_t dst[SIZE];
@@ -15,10 +694,9 @@ int main() {
         src[i] = i + 1;
 
     // Run accelerator
-    memcopy_accel(src, dst, SIZE * 4);
+    memcopy_accel_word(src, dst, SIZE * 4);
 
     // Verify
-    int errors = 0;
     for (int i = 0; i < SIZE; i++) {
         if (src[i] != dst[i]) {
             std::cout << "Mismatch at " << i << ": " << src[i]
@@ -27,6 +705,53 @@ int main() {
         }
     }
 
+    // Wide-bus kernels against the 32-bit kernel
+    for (int i = 0; i < TB_NUM_WIDE_LENS; i++) {
+        uint32_t len = tb_wide_lens[i];
+        errors += test_wide_vs_32<64>(memcopy_wide<64>, "memcopy_wide", len);
+        errors += test_wide_vs_32<128>(memcopy_wide<128>, "memcopy_wide", len);
+        errors += test_wide_vs_32<64>(memcopy_dataflow<64>, "memcopy_dataflow", len);
+        errors += test_wide_vs_32<128>(memcopy_dataflow<128>, "memcopy_dataflow", len);
+        // Non-default chunk sizes
+        errors += test_wide_vs_32<64>(memcopy_wide<64, 4>, "memcopy_wide/4", len);
+        errors += test_wide_vs_32<128>(memcopy_wide<128, 64>, "memcopy_wide/64", len);
+    }
+
+    // Byte-exact kernel: every src/dst offset within a bus beat
+    errors += test_unaligned_all<64>();
+    errors += test_unaligned_all<128>();
+
+    // Descriptor chain through the top function
+    errors += test_scatter_gather();
+
+    // Rectangular tiles with row pitch
+    errors += test_2d();
+
+    // Write-only fill modes
+    errors += test_fill(MEMCOPY_OP_FILL, 0);
+    errors += test_fill(MEMCOPY_OP_FILL, 0xDEADBEEFu);
+    errors += test_fill(MEMCOPY_OP_PATTERN, 0xA5A50000u);
+
+    // Hardware memcmp
+    errors += test_compare();
+
+    // Byte swap and widening transforms
+    errors += test_transform_all<64>();
+    errors += test_transform_all<128>();
+
+    // Performance counter registers
+    errors += test_perf();
+
+    // Command ring with completion ring and interrupt moderation
+    errors += test_ring();
+
+    // Lengths above 4 GiB
+    errors += test_len64<64>();
+    errors += test_len64<128>();
+#endif
+
+    report_throughput();
+
     if (errors == 0)
         std::cout << "Test passed!" << std::endl;
     else
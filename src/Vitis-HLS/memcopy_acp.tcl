@@ -0,0 +1,61 @@
+# ==============================================================
+# memcopy_accel on the Zynq-7000 ACP (cache-coherent masters)
+#
+# The HLS m_axi adapters drive ARCACHE/AWCACHE and ARUSER/AWUSER from the
+# C_M_AXI_<bundle>_CACHE_VALUE / _USER_VALUE / _USER_WIDTH parameters of
+# the packaged IP (default "0011" and 0, non-coherent). This script sets
+# them on a memcopy_accel cell of the open block design, enables S_AXI_ACP
+# on the PS and connects AXI_SRC and AXI_DST to it. Build the IP with
+# -DMEMCOPY_ACP=1 and the driver with -DMEMCOPY_ACCEL_COHERENT=1.
+#
+# Usage (Vivado Tcl console, block design open):
+#   source memcopy_acp.tcl
+#   memcopy_acp memcopy_accel_0                         ;# coherent, ACP
+#   memcopy_acp memcopy_accel_0 processing_system7_0 0  ;# HLS defaults again
+# ==============================================================
+
+# AxCACHE 1111: write-back, read- and write-allocate. AxUSER[0] = 1 marks
+# the access shared (snooped by the SCU), [4:1] = 1111 inner write-back.
+set memcopy_acp_cache "1111"
+set memcopy_acp_user  0x1F
+
+proc memcopy_acp {cell {ps processing_system7_0} {coherent 1}} {
+    global memcopy_acp_cache memcopy_acp_user
+
+    set ip [get_bd_cells $cell]
+    if {$coherent} {
+        set cache $memcopy_acp_cache
+        set user  $memcopy_acp_user
+        set width 5
+    } else {
+        set cache "0011"
+        set user  0x0
+        set width 1
+    }
+    foreach b {AXI_SRC AXI_DST} {
+        set_property -dict [list \
+            CONFIG.C_M_AXI_${b}_CACHE_VALUE "\"$cache\"" \
+            CONFIG.C_M_AXI_${b}_USER_VALUE $user \
+            CONFIG.C_M_AXI_${b}_USER_WIDTH $width] $ip
+    }
+    if {!$coherent} {
+        return
+    }
+
+    # Take AxUSER from the masters rather than the PS tie-off value
+    set_property -dict [list \
+        CONFIG.PCW_USE_S_AXI_ACP {1} \
+        CONFIG.PCW_USE_DEFAULT_ACP_USER_VAL {0}] [get_bd_cells $ps]
+
+    foreach b {AXI_SRC AXI_DST} {
+        set m [get_bd_intf_pins $cell/m_axi_$b]
+        foreach net [get_bd_intf_nets -quiet -of_objects $m] {
+            delete_bd_objs $net
+        }
+        apply_bd_automation -rule xilinx.com:bd_rule:axi4 -config [list \
+            Clk_master {Auto} Clk_slave {Auto} Clk_xbar {Auto} \
+            Master /$cell/m_axi_$b Slave /$ps/S_AXI_ACP \
+            intc_ip {Auto} master_apm {0}] [get_bd_intf_pins $ps/S_AXI_ACP]
+    }
+    validate_bd_design
+}
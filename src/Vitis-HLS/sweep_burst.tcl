@@ -0,0 +1,87 @@
+# ==============================================================
+# memcopy_accel burst / outstanding-transaction sweep
+#
+# Builds one HLS project per (bus width, max burst, outstanding) setting,
+# runs csynth + cosim on the selected top and collects bytes per cycle
+# from the cosim latency of a single TB_BENCH_BYTES copy.
+#
+# Usage (from src/Vitis-HLS):
+#   vitis_hls -f sweep_burst.tcl                      ;# memcopy_accel_dataflow
+#   vitis_hls -f sweep_burst.tcl -tclargs memcopy_accel_wide
+#
+# Results: sweep/sweep_results.csv and a table on the console.
+# ==============================================================
+
+set top         memcopy_accel_dataflow
+if {[info exists argv] && [llength $argv] > 0} {
+    set top [lindex $argv 0]
+}
+
+set part        xc7z010clg400-1   ;# Zybo Z7-10
+set period      10                ;# 100 MHz FCLK_CLK0
+set bench_bytes 65536
+
+set widths      {64 128}
+set bursts      {4 8 16 32 64}
+set outstanding {1 2 4 8 16}
+
+# Average latency (cycles) from a cosim report, or -1 if it is missing
+proc cosim_latency {rpt} {
+    if {![file exists $rpt]} { return -1 }
+    set fp [open $rpt r]
+    set lat -1
+    while {[gets $fp line] >= 0} {
+        # | Verilog | Pass | min | avg | max | ...
+        if {[regexp {^\|\s*(Verilog|VHDL)\s*\|\s*Pass\s*\|\s*(\d+)\s*\|\s*(\d+)\s*\|} $line -> lang lmin lavg]} {
+            set lat $lavg
+            break
+        }
+    }
+    close $fp
+    return $lat
+}
+
+file mkdir sweep
+set csv [open sweep/sweep_results.csv w]
+puts $csv "top,width,max_burst,outstanding,latency_cycles,bytes_per_cycle"
+set rows {}
+
+foreach w $widths {
+    foreach b $bursts {
+        foreach o $outstanding {
+            set name   "${top}_w${w}_b${b}_o${o}"
+            set cflags "-DMEMCOPY_BUS_WIDTH=$w -DMEMCOPY_MAX_BURST=$b -DMEMCOPY_NUM_OUTSTANDING=$o"
+            set tbflags "$cflags -DTB_BENCH_ONLY -DTB_BENCH_ITERS=1 -DTB_BENCH_BYTES=$bench_bytes"
+
+            open_project -reset sweep/$name
+            set_top $top
+            add_files memcopy_accel.cpp -cflags $cflags
+            add_files -tb memcopy_accel_test.cpp -cflags $tbflags
+            open_solution -reset sol1 -flow_target vivado
+            set_part $part
+            create_clock -period $period -name default
+
+            csynth_design
+            cosim_design
+
+            set lat [cosim_latency sweep/$name/sol1/sim/report/${top}_cosim.rpt]
+            if {$lat > 0} {
+                set bpc [format "%.3f" [expr {double($bench_bytes) / $lat}]]
+            } else {
+                set bpc "n/a"
+            }
+            puts $csv "$top,$w,$b,$o,$lat,$bpc"
+            flush $csv
+            lappend rows [list $w $b $o $lat $bpc]
+            close_project
+        }
+    }
+}
+close $csv
+
+puts ""
+puts "memcopy sweep: $top, $bench_bytes bytes per call"
+puts [format "%6s %6s %6s %12s %10s" width burst outst cycles bytes/cyc]
+foreach r $rows {
+    puts [format "%6s %6s %6s %12s %10s" {*}$r]
+}